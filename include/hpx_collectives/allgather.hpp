@@ -0,0 +1,29 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_ALLGATHER_HPP__
+#define __HPX_ALLGATHER_HPP__
+
+#include "collective_traits.hpp" 
+
+namespace hpx { namespace utils { namespace collectives {
+
+template< typename CommunicationPattern, typename BlockingPolicy, typename Serialization >
+class allgather {
+public:
+    using communication_pattern = CommunicationPattern;
+    using blocking_policy = BlockingPolicy;
+
+    allgather();
+
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg);
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+
+#endif
@@ -0,0 +1,139 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_ALLGATHER_BINOMIAL_HPP__
+#define __HPX_ALLGATHER_BINOMIAL_HPP__
+
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include "collective_traits.hpp"
+#include "allgather.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "slots.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// binomial gather to rank 0, then rank 0 streams the gathered bytes down
+// the chain of ranks in segment_n segments; every rank forwards a segment
+// as soon as it lands, so the broadcast costs about (p + segment_n) times
+// a segment instead of log2 p times the whole buffer. suits large blocks,
+// where bandwidth matters more than latency
+//
+template< typename BlockingPolicy, typename Serialization >
+class allgather< tree_binomial, BlockingPolicy, Serialization > {
+
+    using mailbox_t = slots::mailbox_t< std::vector<std::string> >;
+
+private:
+    communicator comm;
+    std::int64_t segment_n;
+    mailbox<mailbox_t> args;
+
+    // 0 .. rounds - 1: gather, one per binomial round
+    // rounds: block lengths
+    // rounds + 1 ..: segments
+    //
+    std::int64_t header_slot() const { return slots::rounds(comm.rank_n()); }
+
+public:
+    using communication_pattern = hpx::utils::collectives::tree_binomial;
+    using blocking_policy = BlockingPolicy;
+
+    allgather(const std::string agas_name) :
+        allgather(agas_name, communicator{}) {
+    }
+
+    allgather(const std::string agas_name, const communicator & comm_, const std::int64_t segment_n_=8) :
+        comm(comm_),
+        segment_n(std::max(segment_n_, std::int64_t{1})),
+        args{comm.attach(agas_name, slots::make_mailbox< std::vector<std::string> >(slots::rounds(comm.rank_n()) + 1 + segment_n))} {
+    }
+
+    // every rank contributes [input_beg, input_end); out_beg receives the
+    // contributions of all ranks in rank order
+    //
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg) {
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        const std::int64_t rank_n = comm.rank_n();
+        const std::int64_t rank_me = comm.rank_me();
+        const binomial_schedule tree = comm.schedule();
+
+        // a subtree covers ranks [rank_me, rank_me + subtree_n) and the
+        // children are nearest first, so appending keeps rank order
+        //
+        std::vector<std::string> blocks{};
+        blocks.reserve(tree.subtree_n(rank_me));
+        blocks.push_back(serialization::pack_range<Serialization>(input_beg, input_end));
+
+        for(const auto & child : tree.children(rank_me)) {
+            std::vector<std::string> recv = slots::wait(args, child.second);
+            std::move(recv.begin(), recv.end(), std::back_inserter(blocks));
+        }
+
+        const std::int64_t next = rank_me + 1;
+
+        std::vector<std::int64_t> lengths{};
+        std::string gathered{};
+
+        if(rank_me != 0) {
+            std::int64_t round = 0;
+            const std::int64_t parent = tree.parent(rank_me, round);
+            slots::post(args, comm.global(parent), round, std::move(blocks));
+
+            std::vector<std::string> header = slots::wait(args, header_slot());
+            if(next < rank_n) { slots::post(args, comm.global(next), header_slot(), std::vector<std::string>(header)); }
+            lengths = serialization::unpack< Serialization, std::vector<std::int64_t> >(header.front());
+
+            for(std::int64_t segment = 0; segment < segment_n; ++segment) {
+                std::vector<std::string> recv = slots::wait(args, header_slot() + 1 + segment);
+                if(next < rank_n) { slots::post(args, comm.global(next), header_slot() + 1 + segment, std::vector<std::string>(recv)); }
+                gathered.append(recv.front());
+            }
+        }
+        else {
+            lengths.reserve(rank_n);
+            for(auto & block : blocks) {
+                lengths.push_back(static_cast<std::int64_t>(block.size()));
+                gathered.append(block);
+            }
+
+            if(next < rank_n) {
+                slots::post(args, comm.global(next), header_slot(), std::vector<std::string>{serialization::pack<Serialization>(lengths)});
+
+                const std::size_t segment_size = (gathered.size() + segment_n - 1) / segment_n;
+                for(std::int64_t segment = 0; segment < segment_n; ++segment) {
+                    const std::size_t offset = std::min(gathered.size(), segment * segment_size);
+                    slots::post(
+                        args, comm.global(next), header_slot() + 1 + segment,
+                        std::vector<std::string>{gathered.substr(offset, segment_size)}
+                    );
+                }
+            }
+        }
+
+        std::size_t offset = 0;
+        for(const auto length : lengths) {
+            out_beg = serialization::unpack_range<Serialization, value_type>(gathered.substr(offset, length), out_beg);
+            offset += length;
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
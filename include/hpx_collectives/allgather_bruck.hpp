@@ -0,0 +1,94 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_ALLGATHER_BRUCK_HPP__
+#define __HPX_ALLGATHER_BRUCK_HPP__
+
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include "collective_traits.hpp"
+#include "allgather.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "slots.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// ceil(log2 p) rounds for any p; in round k every rank sends the blocks
+// it holds, up to p - 2^k of them, to rank - 2^k and appends the ones
+// from rank + 2^k, so each block crosses the network once per hop
+//
+template< typename BlockingPolicy, typename Serialization >
+class allgather< topology_bruck, BlockingPolicy, Serialization > {
+
+    using mailbox_t = slots::mailbox_t< std::vector<std::string> >;
+
+private:
+    communicator comm;
+    mailbox<mailbox_t> args;
+
+public:
+    using communication_pattern = hpx::utils::collectives::topology_bruck;
+    using blocking_policy = BlockingPolicy;
+
+    allgather(const std::string agas_name) :
+        allgather(agas_name, communicator{}) {
+    }
+
+    allgather(const std::string agas_name, const communicator & comm_) :
+        comm(comm_),
+        args{comm.attach(agas_name, slots::make_mailbox< std::vector<std::string> >(slots::rounds(comm.rank_n())))} {
+    }
+
+    // every rank contributes [input_beg, input_end); out_beg receives the
+    // contributions of all ranks in rank order
+    //
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg) {
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        const std::int64_t rank_n = comm.rank_n();
+        const std::int64_t rank_me = comm.rank_me();
+
+        // blocks[i] belongs to rank (rank_me + i) % rank_n
+        //
+        std::vector<std::string> blocks{};
+        blocks.reserve(rank_n);
+        blocks.push_back(serialization::pack_range<Serialization>(input_beg, input_end));
+
+        for(std::int64_t round = 0; (std::int64_t{1} << round) < rank_n; ++round) {
+            const std::int64_t distance = std::int64_t{1} << round;
+            const std::int64_t count = std::min(distance, rank_n - distance);
+
+            slots::post(
+                args, comm.global((rank_me - distance + rank_n) % rank_n), round,
+                std::vector<std::string>(blocks.begin(), blocks.begin() + count)
+            );
+
+            std::vector<std::string> recv = slots::wait(args, round);
+            std::move(recv.begin(), recv.end(), std::back_inserter(blocks));
+        }
+
+        for(std::int64_t rank = 0; rank < rank_n; ++rank) {
+            out_beg = serialization::unpack_range<Serialization, value_type>(
+                blocks[(rank - rank_me + rank_n) % rank_n], out_beg
+            );
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
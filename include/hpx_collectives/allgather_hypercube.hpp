@@ -0,0 +1,106 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_ALLGATHER_HYPERCUBE_HPP__
+#define __HPX_ALLGATHER_HYPERCUBE_HPP__
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+
+#include "collective_traits.hpp"
+#include "allgather.hpp"
+#include "allgather_bruck.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "slots.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// recursive doubling; in round k every rank swaps the 2^k blocks it holds
+// with rank ^ 2^k. needs a power of two number of ranks, other sizes run
+// the Bruck algorithm instead
+//
+template< typename BlockingPolicy, typename Serialization >
+class allgather< topology_hypercube, BlockingPolicy, Serialization > {
+
+    using mailbox_t = slots::mailbox_t< std::vector<std::string> >;
+
+private:
+    communicator comm;
+    mailbox<mailbox_t> args;
+    std::unique_ptr< allgather< topology_bruck, BlockingPolicy, Serialization > > bruck;
+
+    static bool power_of_two(const std::int64_t n) { return (n & (n - 1)) == 0; }
+
+public:
+    using communication_pattern = hpx::utils::collectives::topology_hypercube;
+    using blocking_policy = BlockingPolicy;
+
+    allgather(const std::string agas_name) :
+        allgather(agas_name, communicator{}) {
+    }
+
+    allgather(const std::string agas_name, const communicator & comm_) :
+        comm(comm_),
+        args{comm.attach(agas_name, slots::make_mailbox< std::vector<std::string> >(slots::rounds(comm.rank_n())))},
+        bruck() {
+        if(!power_of_two(comm.rank_n())) {
+            bruck = std::make_unique< allgather< topology_bruck, BlockingPolicy, Serialization > >(agas_name + "_bruck", comm);
+        }
+    }
+
+    // every rank contributes [input_beg, input_end); out_beg receives the
+    // contributions of all ranks in rank order
+    //
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg) {
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        if(bruck) {
+            (*bruck)(input_beg, input_end, out_beg);
+            return;
+        }
+
+        const std::int64_t rank_n = comm.rank_n();
+        const std::int64_t rank_me = comm.rank_me();
+
+        // blocks[i] belongs to rank i
+        //
+        std::vector<std::string> blocks(rank_n);
+        blocks[rank_me] = serialization::pack_range<Serialization>(input_beg, input_end);
+
+        for(std::int64_t round = 0; (std::int64_t{1} << round) < rank_n; ++round) {
+            const std::int64_t distance = std::int64_t{1} << round;
+            const std::int64_t partner = rank_me ^ distance;
+            const std::int64_t held = rank_me & ~(distance - 1);
+
+            slots::post(
+                args, comm.global(partner), round,
+                std::vector<std::string>(blocks.begin() + held, blocks.begin() + held + distance)
+            );
+
+            std::vector<std::string> recv = slots::wait(args, round);
+            std::move(recv.begin(), recv.end(), blocks.begin() + (partner & ~(distance - 1)));
+        }
+
+        for(const auto & block : blocks) {
+            out_beg = serialization::unpack_range<Serialization, value_type>(block, out_beg);
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
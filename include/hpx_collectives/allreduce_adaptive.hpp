@@ -0,0 +1,64 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_ALLREDUCE_ADAPTIVE_HPP__
+#define __HPX_ALLREDUCE_ADAPTIVE_HPP__
+
+#include <string>
+#include <cstdint>
+#include <iterator>
+
+#include "collective_traits.hpp"
+#include "allreduce.hpp"
+#include "communicator.hpp"
+#include "reduce_adaptive.hpp"
+#include "broadcast_tree.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// adaptive reduce to rank 0, then a k-nomial broadcast; the broadcast
+// forwards on receipt, so a late rank only delays its own copy and the
+// tree it runs on needs no placement
+//
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class allreduce< tree_adaptive<K>, BlockingPolicy, Serialization > {
+
+private:
+    communicator comm;
+    reduce< tree_adaptive<K>, nonblocking, Serialization > reduce_phase;
+    broadcast< tree_knomial<K>, nonblocking, Serialization > broadcast_phase;
+
+public:
+    using communication_pattern = tree_adaptive<K>;
+    using blocking_policy = BlockingPolicy;
+
+    allreduce(const std::string agas_name, const std::int64_t period_=16) :
+        allreduce(agas_name, communicator{}, period_) {
+    }
+
+    allreduce(const std::string agas_name, const communicator & comm_, const std::int64_t period_=16) :
+        comm(comm_),
+        reduce_phase(agas_name + "_reduce", comm, 0, period_),
+        broadcast_phase(agas_name + "_broadcast", comm, 0) {
+    }
+
+    const straggler_placement<K> & placement() const { return reduce_phase.placement(); }
+
+    template<typename InputIterator, typename BinaryOp>
+    void operator()(InputIterator input_beg, InputIterator input_end, typename std::iterator_traits<InputIterator>::value_type init, BinaryOp op, typename std::iterator_traits<InputIterator>::value_type & output) {
+        reduce_phase(input_beg, input_end, init, op, output);
+        broadcast_phase(output);
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
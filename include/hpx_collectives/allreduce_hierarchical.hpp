@@ -0,0 +1,75 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_ALLREDUCE_HIERARCHICAL_HPP__
+#define __HPX_ALLREDUCE_HIERARCHICAL_HPP__
+
+#include <string>
+#include <iterator>
+
+#include "collective_traits.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "node_map.hpp"
+#include "allreduce.hpp"
+#include "reduce_hierarchical.hpp"
+#include "broadcast_hierarchical.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// reduce to rank 0 and broadcast back; both phases share one
+// node_map, so the intra-node steps never cross the network. ranks are
+// combined node by node, so op must be commutative (see is_commutative)
+//
+template< typename BlockingPolicy, typename Serialization >
+class allreduce< tree_hierarchical, BlockingPolicy, Serialization > {
+
+private:
+    communicator comm;
+    node_map nodes;
+    reduce< tree_hierarchical, nonblocking, Serialization > reduce_phase;
+    broadcast< tree_hierarchical, nonblocking, Serialization > broadcast_phase;
+
+public:
+    using communication_pattern = hpx::utils::collectives::tree_hierarchical;
+    using blocking_policy = BlockingPolicy;
+
+    allreduce(const std::string agas_name) :
+        allreduce(agas_name, communicator{}) {
+    }
+
+    allreduce(const std::string agas_name, const node_map & nodes_) :
+        allreduce(agas_name, communicator{}, nodes_) {
+    }
+
+    allreduce(const std::string agas_name, const communicator & comm_) :
+        allreduce(agas_name, comm_, node_map{agas_name + "_node_map", comm_}) {
+    }
+
+    allreduce(const std::string agas_name, const communicator & comm_, const node_map & nodes_) :
+        comm(comm_),
+        nodes(nodes_),
+        reduce_phase(agas_name + "_reduce", comm, nodes, 0),
+        broadcast_phase(agas_name + "_broadcast", comm, nodes, 0) {
+    }
+
+    template<typename InputIterator, typename BinaryOp>
+    void operator()(InputIterator input_beg, InputIterator input_end, typename std::iterator_traits<InputIterator>::value_type init, BinaryOp op, typename std::iterator_traits<InputIterator>::value_type & output) {
+        static_assert(is_commutative<BinaryOp>::value, "hpx_collectives allreduce: a hierarchical tree combines ranks node by node, op must be commutative");
+        reduce_phase(input_beg, input_end, init, op, output);
+        broadcast_phase(output);
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
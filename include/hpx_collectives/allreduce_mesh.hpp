@@ -0,0 +1,90 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_ALLREDUCE_MESH_HPP__
+#define __HPX_ALLREDUCE_MESH_HPP__
+
+#include <string>
+#include <cstdint>
+#include <iterator>
+
+#include "collective_traits.hpp"
+#include "allreduce.hpp"
+#include "communicator.hpp"
+#include "mesh.hpp"
+#include "reduce_tree.hpp"
+#include "broadcast_tree.hpp"
+#include "allreduce_tree.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// on a mesh_grid: every column reduces into row 0, row 0 allreduces the
+// column results, and every column broadcasts the total from row 0.
+// columns run concurrently in the first and last phase; each phase is a
+// binomial tree of about sqrt(p) ranks, so the critical path is about
+// 2 log2 p steps with no rank handling more than two trees. a short last
+// row is fine, since the rows are only combined in row 0, which is full.
+// ranks are combined column by column, so op must be commutative (see
+// is_commutative)
+//
+template< typename BlockingPolicy, typename Serialization >
+class allreduce< topology_mesh, BlockingPolicy, Serialization > {
+
+private:
+    communicator comm;
+    mesh_grid grid;
+    communicator rows;
+    communicator columns;
+    reduce< tree_binomial, nonblocking, Serialization > column_reduce;
+    allreduce< tree_binomial, nonblocking, Serialization > row_allreduce;
+    broadcast< tree_binomial, nonblocking, Serialization > column_broadcast;
+
+public:
+    using communication_pattern = hpx::utils::collectives::topology_mesh;
+    using blocking_policy = BlockingPolicy;
+
+    allreduce(const std::string agas_name) :
+        allreduce(agas_name, communicator{}) {
+    }
+
+    allreduce(const std::string agas_name, const communicator & comm_) :
+        comm(comm_),
+        grid(comm.rank_n(), 0),
+        rows(grid.row_group(comm, agas_name)),
+        columns(grid.column_group(comm, agas_name)),
+        column_reduce(agas_name + "_column_reduce", columns, 0),
+        row_allreduce(agas_name + "_row_allreduce", rows),
+        column_broadcast(agas_name + "_column_broadcast", columns, 0) {
+    }
+
+    template<typename InputIterator, typename BinaryOp>
+    void operator()(InputIterator input_beg, InputIterator input_end, typename std::iterator_traits<InputIterator>::value_type init, BinaryOp op, typename std::iterator_traits<InputIterator>::value_type & output) {
+        static_assert(is_commutative<BinaryOp>::value, "hpx_collectives allreduce: a mesh combines ranks column by column, op must be commutative");
+        // https://en.cppreference.com/w/cpp/header/iterator
+        //
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        value_type column_result{};
+        column_reduce(input_beg, input_end, init, op, column_result);
+
+        // an empty range, so the column's result is folded in once
+        //
+        if(grid.row(comm.rank_me()) == 0) {
+            row_allreduce(input_end, input_end, column_result, op, output);
+        }
+
+        column_broadcast(output);
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
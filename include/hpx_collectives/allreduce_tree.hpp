@@ -0,0 +1,120 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_ALLREDUCE_TREE_HPP__
+#define __HPX_ALLREDUCE_TREE_HPP__
+
+#include <string>
+#include <cstdint>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include "collective_traits.hpp"
+#include "allreduce.hpp"
+#include "communicator.hpp"
+#include "sparse_vector.hpp"
+#include "compression.hpp"
+#include "reduce_tree.hpp"
+#include "broadcast_tree.hpp"
+
+namespace hpx { namespace utils { namespace collectives { namespace tree {
+
+// reduce to rank 0 and broadcast back down the same tree
+//
+template< typename CommunicationPattern, typename BlockingPolicy, typename Serialization >
+class allreduce {
+
+private:
+    communicator comm;
+    collectives::reduce< CommunicationPattern, nonblocking, Serialization > reduce_phase;
+    collectives::broadcast< CommunicationPattern, nonblocking, Serialization > broadcast_phase;
+
+public:
+    using communication_pattern = CommunicationPattern;
+    using blocking_policy = BlockingPolicy;
+
+    allreduce(const std::string agas_name) :
+        allreduce(agas_name, communicator{}) {
+    }
+
+    allreduce(const std::string agas_name, const communicator & comm_) :
+        comm(comm_),
+        reduce_phase(agas_name + "_reduce", comm, 0),
+        broadcast_phase(agas_name + "_broadcast", comm, 0) {
+    }
+
+    template<typename InputIterator, typename BinaryOp>
+    void operator()(InputIterator input_beg, InputIterator input_end, typename std::iterator_traits<InputIterator>::value_type init, BinaryOp op, typename std::iterator_traits<InputIterator>::value_type & output) {
+        reduce_phase(input_beg, input_end, init, op, output);
+        broadcast_phase(output);
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+    // sparse allreduce; the broadcast ships the result in whichever form
+    // the reduction left it, sparse or dense
+    //
+    template<typename Value, typename BinaryOp>
+    void operator()(const sparse_vector<Value> & input, BinaryOp op, sparse_vector<Value> & output) {
+        reduce_phase(input, op, output);
+        broadcast_phase(output);
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+    // element-wise allreduce over a 16 bit wire, both ways: the root
+    // quantizes the full precision result once more for the broadcast, so
+    // every rank, the root included, gets the same values. op must be
+    // commutative (see is_commutative)
+    //
+    template<typename InputIterator, typename OutputIterator, typename BinaryOp, typename Format>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg, BinaryOp op, quantizer<Format> & codec) {
+        static_assert(is_commutative<BinaryOp>::value, "hpx_collectives allreduce: quantized partial results share one error feedback residual, op must be commutative");
+        // https://en.cppreference.com/w/cpp/header/iterator
+        //
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        std::vector<value_type> result{};
+        reduce_phase(input_beg, input_end, std::back_inserter(result), op, codec);
+
+        std::vector<std::uint16_t> wire{};
+        if(comm.rank_me() == 0) {
+            wire = codec.encode(result);
+        }
+        broadcast_phase(wire);
+
+        const std::vector<value_type> values = codec.template decode<value_type>(wire);
+        std::copy(values.begin(), values.end(), out_beg);
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace tree */
+
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class allreduce< tree_knomial<K>, BlockingPolicy, Serialization > : public tree::allreduce< tree_knomial<K>, BlockingPolicy, Serialization > {
+public:
+    using tree::allreduce< tree_knomial<K>, BlockingPolicy, Serialization >::allreduce;
+};
+
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class allreduce< tree_kary<K>, BlockingPolicy, Serialization > : public tree::allreduce< tree_kary<K>, BlockingPolicy, Serialization > {
+public:
+    using tree::allreduce< tree_kary<K>, BlockingPolicy, Serialization >::allreduce;
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,36 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_ALLTOALLV_HPP__
+#define __HPX_ALLTOALLV_HPP__
+
+#include <vector>
+#include <cstdint>
+
+#include "collective_traits.hpp" 
+
+namespace hpx { namespace utils { namespace collectives {
+
+// every rank sends a block of its own size to every rank; the blocks
+// received come back in rank order
+//
+template< typename CommunicationPattern, typename BlockingPolicy, typename Serialization >
+class alltoallv {
+public:
+    using communication_pattern = CommunicationPattern;
+    using blocking_policy = BlockingPolicy;
+
+    alltoallv();
+
+    // returns the number of elements received from every rank
+    //
+    template<typename InputIterator, typename OutputIterator>
+    std::vector<std::int64_t> operator()(InputIterator input_beg, InputIterator input_end, const std::vector<std::int64_t> & counts, OutputIterator out_beg);
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
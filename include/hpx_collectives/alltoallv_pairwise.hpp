@@ -0,0 +1,103 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_ALLTOALLV_PAIRWISE_HPP__
+#define __HPX_ALLTOALLV_PAIRWISE_HPP__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+#include "collective_traits.hpp"
+#include "alltoallv.hpp"
+#include "distribution.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "slots.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// one message per pair of ranks, sent in pairwise order; slot s receives
+// from rank s. trivially copyable elements travel as raw bytes, anything
+// else through Serialization (see serialization::pack_values)
+//
+template< typename BlockingPolicy, typename Serialization >
+class alltoallv< topology_pairwise, BlockingPolicy, Serialization > {
+
+    using mailbox_t = slots::mailbox_t<std::string>;
+
+private:
+    communicator comm;
+    mailbox<mailbox_t> args;
+
+public:
+    using communication_pattern = hpx::utils::collectives::topology_pairwise;
+    using blocking_policy = BlockingPolicy;
+
+    alltoallv(const std::string agas_name) :
+        alltoallv(agas_name, communicator{}) {
+    }
+
+    alltoallv(const std::string agas_name, const communicator & comm_) :
+        comm(comm_),
+        args{comm.attach(agas_name, slots::make_mailbox<std::string>(comm.rank_n()))} {
+    }
+
+    // [input_beg, input_end) holds rank_n blocks back to back, counts[r]
+    // elements for rank r; the blocks every rank sent this rank are
+    // written to out_beg in rank order, and their lengths returned
+    //
+    template<typename InputIterator, typename OutputIterator>
+    std::vector<std::int64_t> operator()(InputIterator input_beg, InputIterator input_end, const std::vector<std::int64_t> & counts, OutputIterator out_beg) {
+        // https://en.cppreference.com/w/cpp/header/iterator
+        //
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        const std::int64_t rank_n = comm.rank_n();
+        const std::int64_t rank_me = comm.rank_me();
+
+        if(static_cast<std::int64_t>(counts.size()) != rank_n) {
+            throw std::length_error("hpx_collectives alltoallv: one count per rank expected");
+        }
+
+        const std::vector<std::int64_t> displs = displacements(counts);
+        if(displs.back() + counts.back() > static_cast<std::int64_t>(std::distance(input_beg, input_end))) {
+            throw std::length_error("hpx_collectives alltoallv: counts exceed the input");
+        }
+
+        for(std::int64_t step = 1; step < rank_n; ++step) {
+            const std::int64_t target = (rank_me + step) % rank_n;
+            slots::post(args, comm.global(target), rank_me, serialization::pack_values<Serialization>(input_beg + displs[target], counts[target]));
+        }
+
+        std::vector<std::int64_t> received(rank_n, 0);
+        for(std::int64_t source = 0; source < rank_n; ++source) {
+            if(source == rank_me) {
+                out_beg = std::copy(input_beg + displs[rank_me], input_beg + displs[rank_me] + counts[rank_me], out_beg);
+                received[source] = counts[rank_me];
+            }
+            else {
+                out_beg = serialization::unpack_values<Serialization, value_type>(slots::wait(args, source), out_beg, received[source]);
+            }
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+        return received;
+
+    } // end operator()
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
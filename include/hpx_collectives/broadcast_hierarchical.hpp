@@ -0,0 +1,112 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_BROADCAST_HIERARCHICAL_HPP__
+#define __HPX_BROADCAST_HIERARCHICAL_HPP__
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <unistd.h>
+
+#include "collective_traits.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "node_map.hpp"
+#include "hierarchical.hpp"
+#include "broadcast.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+template< typename BlockingPolicy, typename Serialization >
+class broadcast< tree_hierarchical, BlockingPolicy, Serialization > {
+
+    using value_type_t = typename Serialization::value_type;
+    using serializer_t = typename Serialization::serializer;
+    using deserializer_t = typename Serialization::deserializer;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    node_map nodes;
+    mailbox< hierarchical::mailbox_t > args;
+
+public:
+    using communication_pattern = hpx::utils::collectives::tree_hierarchical;
+    using blocking_policy = BlockingPolicy;
+
+    broadcast(const std::string agas_name, const std::int64_t root_=0) :
+        broadcast(agas_name, communicator{}, root_) {
+    }
+
+    broadcast(const std::string agas_name, const node_map & nodes_, const std::int64_t root_=0) :
+        broadcast(agas_name, communicator{}, nodes_, root_) {
+    }
+
+    broadcast(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0) :
+        broadcast(agas_name, comm_, node_map{agas_name + "_node_map", comm_}, root_) {
+    }
+
+    // root and the ranks in nodes are ranks in comm_
+    //
+    broadcast(const std::string agas_name, const communicator & comm_, const node_map & nodes_, const std::int64_t root_=0) :
+        root(root_),
+        comm(comm_),
+        nodes(nodes_),
+        args{comm.attach(agas_name, hierarchical::make_mailbox(nodes.members(nodes.node_of(comm.rank_me())).size()))} {
+    }
+
+    template<typename DataType>
+    void operator()(DataType & data) {
+        const std::int64_t rank_me = comm.rank_me();
+        const hierarchical::schedule sched{nodes, root};
+
+        std::vector<std::string> payload{};
+
+        if(rank_me == root) {
+            value_type_t value_buffer{};
+            serializer_t value_oa{value_buffer};
+            value_oa << data;
+            payload.push_back(Serialization::get_buffer(value_buffer));
+        }
+        else {
+            payload = hierarchical::wait_down(args);
+        }
+
+        if(sched.is_leader(rank_me)) {
+            // farthest leader first, it heads the largest subtree; then
+            // the members of this node
+            //
+            const auto children = sched.children(sched.relative(rank_me));
+            for(auto child = children.rbegin(); child != children.rend(); ++child) {
+                hierarchical::post_down(comm, args, sched.leader_of_relative(child->first), payload);
+            }
+
+            for(const auto member : nodes.members(nodes.node_of(rank_me))) {
+                if(member != rank_me) {
+                    hierarchical::post_down(comm, args, member, payload);
+                }
+            }
+        }
+
+        if(rank_me != root) {
+            value_type_t value_buffer{payload.front()};
+            deserializer_t value_ia{value_buffer};
+            value_ia >> data;
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+    } // end operator()
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
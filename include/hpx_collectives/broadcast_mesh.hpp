@@ -0,0 +1,74 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_BROADCAST_MESH_HPP__
+#define __HPX_BROADCAST_MESH_HPP__
+
+#include <string>
+#include <cstdint>
+
+#include "collective_traits.hpp"
+#include "broadcast.hpp"
+#include "communicator.hpp"
+#include "mesh.hpp"
+#include "broadcast_tree.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// row then columns on a mesh_grid: the root's row broadcasts first, then
+// every column broadcasts from its rank in that row, each phase a
+// binomial tree of about sqrt(p) ranks. a column starts as soon as its
+// first rank has the data, so the columns run concurrently and overlap
+// the row phase
+//
+template< typename BlockingPolicy, typename Serialization >
+class broadcast< topology_mesh, BlockingPolicy, Serialization > {
+
+private:
+    communicator comm;
+    mesh_grid grid;
+    communicator rows;
+    communicator columns;
+    broadcast< tree_binomial, nonblocking, Serialization > row_phase;
+    broadcast< tree_binomial, nonblocking, Serialization > column_phase;
+
+public:
+    using communication_pattern = hpx::utils::collectives::topology_mesh;
+    using blocking_policy = BlockingPolicy;
+
+    broadcast(const std::string agas_name, const std::int64_t root_=0) :
+        broadcast(agas_name, communicator{}, root_) {
+    }
+
+    // root is a rank in comm_
+    //
+    broadcast(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0) :
+        comm(comm_),
+        grid(comm.rank_n(), root_),
+        rows(grid.row_group(comm, agas_name)),
+        columns(grid.column_group(comm, agas_name)),
+        row_phase(agas_name + "_row", rows, 0),
+        column_phase(agas_name + "_column", columns, 0) {
+    }
+
+    template<typename DataType>
+    void operator()(DataType & data) {
+        if(grid.row(comm.rank_me()) == 0) {
+            row_phase(data);
+        }
+
+        column_phase(data);
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
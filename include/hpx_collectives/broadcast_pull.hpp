@@ -0,0 +1,292 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_BROADCAST_PULL_HPP__
+#define __HPX_BROADCAST_PULL_HPP__
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+#include "collective_traits.hpp"
+#include "broadcast.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "mailbox.hpp"
+#include "schedule.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// what one rank of a pull broadcast exposes: the serialized payload of
+// the call it has joined, as far as it has arrived, and the gets it
+// cannot answer yet
+//
+class pull_buffer {
+
+public:
+    struct request {
+        std::int64_t requester;
+        std::int64_t generation;
+        std::int64_t offset;
+    };
+
+    std::mutex mtx;
+    std::int64_t parent = -1;      // locality, -1 on the root
+    std::int64_t chunk = 1;        // bytes per get
+    std::int64_t generation = -1;  // call joined
+    std::int64_t total = -1;       // payload bytes, -1 until known
+    std::string data;              // the payload's first data.size() bytes
+    std::vector<request> parked;
+    std::int64_t acks = 0;         // children done with the current call
+
+    bool complete() const { return total >= 0 && static_cast<std::int64_t>(data.size()) == total; }
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+REGISTER_DISTRIBUTED_OBJECT_PART(std::shared_ptr<hpx::utils::collectives::pull_buffer>);
+
+namespace hpx { namespace utils { namespace collectives {
+
+// one-sided broadcast: the root publishes the serialized value in its
+// mailbox and every other rank gets it, chunk_bytes at a time, from its
+// parent in a k-nomial tree once it calls the broadcast. a parent serves
+// a chunk as soon as it has it, so chunks flow down the tree in a
+// pipeline; and each reply is answered by the handler that delivers it,
+// which asks for the next chunk at once
+//
+// a get sent to a parent that has not joined the call yet is passed on
+// to its parent, so a child that is ready early, or joins late, fetches
+// from the nearest ancestor holding the payload instead of waiting on
+// the ones in between
+//
+// a rank returns once it holds the payload and every child has finished,
+// so its buffer outlives every get that may be sent to it
+//
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class broadcast< tree_pull<K>, BlockingPolicy, Serialization > {
+
+    using mailbox_t = std::shared_ptr<pull_buffer>;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    std::int64_t generation;
+    mailbox<mailbox_t> args;
+
+    // replies carry the call, the offset and the payload size ahead of
+    // the bytes
+    //
+    static std::string reply(const pull_buffer & buffer, const std::int64_t offset) {
+        const std::int64_t header[3] = {buffer.generation, offset, buffer.total};
+        const std::int64_t len = std::min(buffer.chunk, static_cast<std::int64_t>(buffer.data.size()) - offset);
+
+        std::string data(sizeof(header), '\0');
+        std::memcpy(&data[0], header, sizeof(header));
+        data.append(buffer.data, offset, len);
+        return data;
+    }
+
+    static void get(mailbox<mailbox_t> & args_, const std::int64_t target, const pull_buffer::request & req) {
+        args_.post(
+            target,
+            [](mailbox<mailbox_t> & args__, std::int64_t requester, std::int64_t generation_, std::int64_t offset) {
+                serve(args__, pull_buffer::request{requester, generation_, offset});
+            }, req.requester, req.generation, req.offset
+        );
+    }
+
+    static void put(mailbox<mailbox_t> & args_, const std::int64_t target, std::string data) {
+        args_.post(
+            target,
+            [](mailbox<mailbox_t> & args__, std::string data_) {
+                receive(args__, data_);
+            }, std::move(data)
+        );
+    }
+
+    // answers req from this rank's buffer, parks it until the bytes
+    // arrive, or passes it up when this rank has not joined the call
+    //
+    static void serve(mailbox<mailbox_t> & args_, const pull_buffer::request & req) {
+        pull_buffer & buffer = **args_;
+
+        std::string data{};
+        std::int64_t forward_to = -1;
+        {
+            std::lock_guard<std::mutex> lock(buffer.mtx);
+            if(req.generation == buffer.generation) {
+                if(buffer.total < 0 || (req.offset >= static_cast<std::int64_t>(buffer.data.size()) && req.offset < buffer.total)) {
+                    buffer.parked.push_back(req);
+                    return;
+                }
+                data = reply(buffer, req.offset);
+            }
+            else if(buffer.parent < 0) {
+                buffer.parked.push_back(req);
+                return;
+            }
+            else {
+                forward_to = buffer.parent;
+            }
+        }
+
+        if(forward_to < 0) {
+            put(args_, req.requester, std::move(data));
+        }
+        else {
+            get(args_, forward_to, req);
+        }
+    }
+
+    // runs in the handler delivering a reply: appends the chunk, answers
+    // the gets it unblocks and asks for the next chunk
+    //
+    static void receive(mailbox<mailbox_t> & args_, const std::string & data) {
+        pull_buffer & buffer = **args_;
+
+        std::int64_t header[3] = {0, 0, 0};
+        std::memcpy(header, data.data(), sizeof(header));
+
+        std::vector<pull_buffer::request> ready{};
+        std::int64_t next = -1, parent = -1, generation_ = -1;
+        {
+            std::lock_guard<std::mutex> lock(buffer.mtx);
+            if(header[0] != buffer.generation || header[1] != static_cast<std::int64_t>(buffer.data.size())) { return; }
+
+            buffer.total = header[2];
+            buffer.data.append(data, sizeof(header), std::string::npos);
+
+            auto keep = std::partition(buffer.parked.begin(), buffer.parked.end(), [&buffer](const pull_buffer::request & req) {
+                return req.generation == buffer.generation && req.offset < static_cast<std::int64_t>(buffer.data.size());
+            });
+            ready.assign(buffer.parked.begin(), keep);
+            buffer.parked.erase(buffer.parked.begin(), keep);
+
+            if(!buffer.complete()) {
+                next = static_cast<std::int64_t>(buffer.data.size());
+                parent = buffer.parent;
+                generation_ = buffer.generation;
+            }
+        }
+
+        for(const auto & req : ready) { serve(args_, req); }
+
+        if(next >= 0) {
+            get(args_, parent, pull_buffer::request{transport::rank_me(), generation_, next});
+        }
+    }
+
+    void acknowledge(const std::int64_t parent) {
+        args.post(
+            parent,
+            [](mailbox<mailbox_t> & args_) {
+                std::lock_guard<std::mutex> lock((*args_)->mtx);
+                ++(*args_)->acks;
+            }
+        );
+    }
+
+public:
+    using communication_pattern = tree_pull<K>;
+    using blocking_policy = BlockingPolicy;
+
+    broadcast(const std::string agas_name, const std::int64_t root_=0, const std::int64_t chunk_bytes=(1 << 20)) :
+        broadcast(agas_name, communicator{}, root_, chunk_bytes) {
+    }
+
+    // root is a rank in comm_; chunk_bytes must agree on every rank
+    //
+    broadcast(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0, const std::int64_t chunk_bytes=(1 << 20)) :
+        root(root_),
+        comm(comm_),
+        generation(0),
+        args{comm.attach(agas_name, std::make_shared<pull_buffer>())} {
+        const std::int64_t rank_me = comm.relative(comm.rank_me(), root);
+
+        std::lock_guard<std::mutex> lock((*args)->mtx);
+        (*args)->chunk = std::max(chunk_bytes, std::int64_t{1});
+        if(rank_me != 0) {
+            std::int64_t slot = 0;
+            (*args)->parent = comm.global_of_relative(knomial_schedule<K>{comm.rank_n()}.parent(rank_me, slot), root);
+        }
+    }
+
+    template<typename DataType>
+    void operator()(DataType & data) {
+        const knomial_schedule<K> tree{comm.rank_n()};
+        const std::int64_t rank_me = comm.relative(comm.rank_me(), root);
+        const std::int64_t child_n = static_cast<std::int64_t>(tree.children(rank_me).size());
+
+        pull_buffer & buffer = **args;
+        std::vector<pull_buffer::request> parked{};
+        {
+            std::lock_guard<std::mutex> lock(buffer.mtx);
+            buffer.generation = generation;
+            buffer.data.clear();
+            buffer.total = -1;
+
+            if(rank_me == 0) {
+                buffer.data = serialization::pack<Serialization>(data);
+                buffer.total = static_cast<std::int64_t>(buffer.data.size());
+            }
+
+            std::swap(parked, buffer.parked);
+        }
+
+        // gets parked before this rank joined, the root's in particular
+        //
+        for(const auto & req : parked) { serve(args, req); }
+
+        if(rank_me != 0) {
+            get(args, buffer.parent, pull_buffer::request{comm.global(comm.rank_me()), generation, 0});
+
+            while(true) {
+                {
+                    std::lock_guard<std::mutex> lock(buffer.mtx);
+                    if(buffer.complete()) { break; }
+                }
+                transport::yield();
+            }
+
+            data = serialization::unpack<Serialization, DataType>(buffer.data);
+        }
+
+        while(true) {
+            {
+                std::lock_guard<std::mutex> lock(buffer.mtx);
+                if(buffer.acks >= child_n) {
+                    buffer.acks -= child_n;
+                    break;
+                }
+            }
+            transport::yield();
+        }
+
+        if(rank_me != 0) {
+            acknowledge(buffer.parent);
+        }
+
+        ++generation;
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+    } // end operator()
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
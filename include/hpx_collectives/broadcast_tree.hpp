@@ -0,0 +1,157 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_BROADCAST_TREE_HPP__
+#define __HPX_BROADCAST_TREE_HPP__
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <cstdint>
+
+#include "collective_traits.hpp"
+#include "broadcast.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "schedule.hpp"
+#include "mailbox.hpp"
+#include "delta.hpp"
+#include "utils.hpp"
+
+REGISTER_DISTRIBUTED_OBJECT_PART(std::tuple<std::vector<std::int32_t>, std::vector<std::string>, std::vector<std::int64_t>>);
+
+namespace hpx { namespace utils { namespace collectives { namespace tree {
+
+// the root serializes the value once; every other rank deserializes its
+// copy, and the bytes it received are forwarded to its children
+// unchanged by the handler that delivers them, so an interior rank
+// passes the value on as soon as it arrives, whether or not it has
+// called the broadcast yet
+//
+template< typename Schedule, typename BlockingPolicy, typename Serialization >
+class broadcast {
+
+    // 0: arrival flag
+    // 1: payload
+    // 2: localities of this rank's children, farthest first
+    //
+    using mailbox_t = std::tuple< std::vector<std::int32_t>, std::vector<std::string>, std::vector<std::int64_t> >;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    mailbox<mailbox_t> args;
+    std::string previous;
+
+    // farthest child first; in a k-nomial tree it heads the largest subtree
+    //
+    static std::vector<std::int64_t> forward_targets(const communicator & comm_, const std::int64_t root_) {
+        const Schedule tree{comm_.rank_n()};
+        const auto children = tree.children(comm_.relative(comm_.rank_me(), root_));
+
+        std::vector<std::int64_t> targets{};
+        targets.reserve(children.size());
+        for(auto child = children.rbegin(); child != children.rend(); ++child) {
+            targets.push_back(comm_.global_of_relative(child->first, root_));
+        }
+        return targets;
+    }
+
+    static void forward(mailbox<mailbox_t> & args_, const std::string & payload) {
+        for(const std::int64_t target : std::get<2>(*args_)) {
+            args_.post(
+                target,
+                [](mailbox<mailbox_t> & args__, std::string payload_) {
+                    forward(args__, payload_);
+                    std::get<1>(*args__)[0] = std::move(payload_);
+                    atomic_xchange( &std::get<0>(*args__)[0], 0, 1 );
+                }, std::string(payload)
+            );
+        }
+    }
+
+    std::string receive() {
+        while(!atomic_xchange( &std::get<0>(*args)[0], 1, 0 )) { transport::yield(); }
+        return std::move(std::get<1>(*args)[0]);
+    }
+
+public:
+    using blocking_policy = BlockingPolicy;
+
+    broadcast(const std::string agas_name, const std::int64_t root_=0) :
+        broadcast(agas_name, communicator{}, root_) {
+    }
+
+    // root is a rank in comm_
+    //
+    broadcast(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0) :
+        root(root_),
+        comm(comm_),
+        args{comm.attach(agas_name, std::make_tuple(std::vector<std::int32_t>(1, 0), std::vector<std::string>(1), forward_targets(comm, root)))},
+        previous() {
+    }
+
+    template<typename DataType>
+    void operator()(DataType & data) {
+        if(comm.rank_me() == root) {
+            forward(args, serialization::pack<Serialization>(data));
+        }
+        else {
+            data = serialization::unpack<Serialization, DataType>(receive());
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+    } // end operator()
+
+    // incremental broadcast: every rank keeps the serialized value of the
+    // previous incremental call, and the root sends only a hash when the
+    // value is unchanged, the chunks that changed otherwise (see
+    // delta.hpp). every rank must make the same sequence of incremental
+    // calls; a rank whose copy has diverged throws instead of returning
+    // a wrong value
+    //
+    template<typename DataType>
+    void operator()(DataType & data, const incremental & options) {
+        if(comm.rank_me() == root) {
+            std::string payload = serialization::pack<Serialization>(data);
+            forward(args, delta::encode(previous, payload, options.chunks));
+            previous = std::move(payload);
+        }
+        else {
+            previous = delta::decode(previous, receive());
+            data = serialization::unpack<Serialization, DataType>(previous);
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace tree */
+
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class broadcast< tree_knomial<K>, BlockingPolicy, Serialization > : public tree::broadcast< knomial_schedule<K>, BlockingPolicy, Serialization > {
+public:
+    using communication_pattern = tree_knomial<K>;
+    using tree::broadcast< knomial_schedule<K>, BlockingPolicy, Serialization >::broadcast;
+};
+
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class broadcast< tree_kary<K>, BlockingPolicy, Serialization > : public tree::broadcast< kary_schedule<K>, BlockingPolicy, Serialization > {
+public:
+    using communication_pattern = tree_kary<K>;
+    using tree::broadcast< kary_schedule<K>, BlockingPolicy, Serialization >::broadcast;
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -5,8 +5,11 @@
 //
 #pragma once
 #ifndef __HPX_COLLECTIVE_TRAITS_HPP__
-#define __HPX_COLLECTIVE_TRATIS_HPP__
+#define __HPX_COLLECTIVE_TRAITS_HPP__
 
+#include <cstdint>
+#include <utility>
+#include <functional>
 #include <type_traits>
 
 namespace hpx { namespace utils { namespace collectives {
@@ -22,10 +25,36 @@ template<>
 struct is_blocking<blocking> : public std::true_type {
 };
 
-struct tree_binomial {};
-struct tree_binary {};
+// k-nomial tree of radix K, see knomial_schedule
+//
+template<std::int64_t K>
+struct tree_knomial {};
 
-template<typename Blocking>
+// k-ary tree of radix K, see kary_schedule
+//
+template<std::int64_t K>
+struct tree_kary {};
+
+using tree_binomial = tree_knomial<2>;
+using tree_binary = tree_kary<2>;
+
+template<typename CommunicationPattern>
+struct is_tree_knomial : public std::false_type {
+};
+
+template<std::int64_t K>
+struct is_tree_knomial< tree_knomial<K> > : public std::true_type {
+};
+
+template<typename CommunicationPattern>
+struct is_tree_kary : public std::false_type {
+};
+
+template<std::int64_t K>
+struct is_tree_kary< tree_kary<K> > : public std::true_type {
+};
+
+template<typename CommunicationPattern>
 struct is_tree_binomial : public std::false_type {
 };
 
@@ -38,13 +67,63 @@ struct is_tree_binary : public std::false_type {
 };
 
 template<>
-struct is_tree_binary<tree_binomial> : public std::true_type {
+struct is_tree_binary<tree_binary> : public std::true_type {
+};
+
+// k-nomial tree of radix K whose ranks are placed on tree positions by
+// observed arrival times, see straggler_placement
+//
+template<std::int64_t K>
+struct tree_adaptive {};
+
+using tree_adaptive_binomial = tree_adaptive<2>;
+
+template<typename CommunicationPattern>
+struct is_tree_adaptive : public std::false_type {
+};
+
+template<std::int64_t K>
+struct is_tree_adaptive< tree_adaptive<K> > : public std::true_type {
+};
+
+// k-nomial tree of radix K traversed by pulling: children fetch the
+// payload in chunks from their parent, see broadcast_pull
+//
+template<std::int64_t K>
+struct tree_pull {};
+
+using tree_pull_binomial = tree_pull<2>;
+
+template<typename CommunicationPattern>
+struct is_tree_pull : public std::false_type {
+};
+
+template<std::int64_t K>
+struct is_tree_pull< tree_pull<K> > : public std::true_type {
+};
+
+// two levels: localities sharing a host combine through a node leader,
+// node leaders run a binomial tree
+//
+struct tree_hierarchical {};
+
+template<typename CommunicationPattern>
+struct is_tree_hierarchical : public std::false_type {
+};
+
+template<>
+struct is_tree_hierarchical<tree_hierarchical> : public std::true_type {
 };
 
 struct topology_ring {};
 struct topology_mesh {};
 struct topology_hypercube {};
 
+// dissemination pattern of Bruck et al.; round k talks to rank +/- 2^k
+// modulo p, so it works for any p
+//
+struct topology_bruck {};
+
 template<typename CommunicationPattern>
 struct is_topology_ring : public std::false_type {
 };
@@ -69,7 +148,94 @@ template<>
 struct is_topology_hypercube<topology_hypercube> : public std::true_type {
 };
 
+template<typename CommunicationPattern>
+struct is_topology_bruck : public std::false_type {
+};
+
+template<>
+struct is_topology_bruck<topology_bruck> : public std::true_type {
+};
+
+// pairwise exchange: in step s every rank r sends to r + s and receives
+// from r - s, modulo p, so no rank is the target of every sender at once
+//
+struct topology_pairwise {};
+
+template<typename CommunicationPattern>
+struct is_topology_pairwise : public std::false_type {
+};
+
+template<>
+struct is_topology_pairwise<topology_pairwise> : public std::true_type {
+};
+
+// keyed collectives: every key is owned by the locality its hash selects
+//
+struct partition_hash {};
+
+template<typename CommunicationPattern>
+struct is_partition_hash : public std::false_type {
+};
+
+template<>
+struct is_partition_hash<partition_hash> : public std::true_type {
+};
 
+// reductions fold a commutative op in the order contributions arrive,
+// and any other op in rank order. the standard arithmetic, bitwise and
+// logical function objects count as commutative on arithmetic types
+// only: std::plus<std::string> concatenates, and the transparent
+// std::plus<> could be handed anything. wrap any other op that commutes,
+// a lambda or std::plus<> for instance, in commutative{op}
+//
+template<typename BinaryOp>
+struct commutative {
+    BinaryOp op;
+
+    template<typename T, typename U>
+    auto operator()(T && lhs, U && rhs) const {
+        return op(std::forward<T>(lhs), std::forward<U>(rhs));
+    }
+};
+
+template<typename BinaryOp>
+commutative(BinaryOp) -> commutative<BinaryOp>;
+
+template<typename BinaryOp>
+struct is_commutative : public std::false_type {
+};
+
+template<typename BinaryOp>
+struct is_commutative< commutative<BinaryOp> > : public std::true_type {
+};
+
+template<typename T>
+struct is_commutative< std::plus<T> > : public std::is_arithmetic<T> {
+};
+
+template<typename T>
+struct is_commutative< std::multiplies<T> > : public std::is_arithmetic<T> {
+};
+
+template<typename T>
+struct is_commutative< std::bit_and<T> > : public std::is_arithmetic<T> {
+};
+
+template<typename T>
+struct is_commutative< std::bit_or<T> > : public std::is_arithmetic<T> {
+};
+
+template<typename T>
+struct is_commutative< std::bit_xor<T> > : public std::is_arithmetic<T> {
+};
+
+template<typename T>
+struct is_commutative< std::logical_and<T> > : public std::is_arithmetic<T> {
+};
+
+template<typename T>
+struct is_commutative< std::logical_or<T> > : public std::is_arithmetic<T> {
+};
 
 } /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
 
@@ -9,18 +9,62 @@
 
 #include "collective_traits.hpp"
 #include "serialization.hpp"
+#include "transport.hpp"
+#include "mailbox.hpp"
+#include "communicator.hpp"
+#include "delta.hpp"
 #include "broadcast.hpp"
-#include "broadcast_binomial.hpp"
-#include "broadcast_binary.hpp"
+#include "broadcast_tree.hpp"
+#include "broadcast_mesh.hpp"
+#include "broadcast_pull.hpp"
+#include "broadcast_hierarchical.hpp"
 #include "scatter.hpp"
-#include "scatter_binomial.hpp"
-#include "scatter_binary.hpp"
+#include "scatter_tree.hpp"
+#include "scatter_hierarchical.hpp"
 #include "gather.hpp"
-#include "gather_binary.hpp"
-#include "gather_binomial.hpp"
+#include "gather_tree.hpp"
+#include "gather_hierarchical.hpp"
+#include "distribution.hpp"
+#include "scatterv.hpp"
+#include "scatterv_binomial.hpp"
+#include "stream_source.hpp"
+#include "scatter_stream.hpp"
+#include "scatter_dynamic.hpp"
+#include "gatherv.hpp"
+#include "gatherv_binomial.hpp"
+#include "stream_sink.hpp"
+#include "gather_stream.hpp"
+#include "operators.hpp"
+#include "sparse_vector.hpp"
+#include "compression.hpp"
 #include "reduce.hpp"
-#include "reduce_binary.hpp"
-#include "reduce_binomial.hpp"
+#include "reduce_tree.hpp"
+#include "reduce_mesh.hpp"
+#include "reduce_adaptive.hpp"
+#include "reduce_hierarchical.hpp"
+#include "reduce_by_key.hpp"
+#include "reduce_by_key_tree.hpp"
+#include "reduce_by_key_hash.hpp"
+#include "allreduce.hpp"
+#include "allreduce_tree.hpp"
+#include "allreduce_mesh.hpp"
+#include "allreduce_adaptive.hpp"
+#include "allreduce_hierarchical.hpp"
+#include "allgather.hpp"
+#include "allgather_hypercube.hpp"
+#include "allgather_bruck.hpp"
+#include "allgather_binomial.hpp"
+#include "alltoallv.hpp"
+#include "alltoallv_pairwise.hpp"
+#include "radix_sort.hpp"
+#include "sample_sort.hpp"
+#include "mesh.hpp"
+#include "neighbor_allgather.hpp"
+#include "neighbor_alltoall.hpp"
+#include "neighbor_mesh.hpp"
+#include "prefix.hpp"
+#include "scan.hpp"
+#include "exscan.hpp"
 
 namespace hpx { namespace utils { namespace collectives {
 
@@ -83,6 +127,9 @@ using blocking_binomial_broadcast = hpx::utils::collectives::scalar_collective<h
 using nonblocking_binary_broadcast = hpx::utils::collectives::scalar_collective<hpx::utils::collectives::broadcast<hpx::utils::collectives::tree_binary, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
 using blocking_binary_broadcast = hpx::utils::collectives::scalar_collective<hpx::utils::collectives::broadcast<hpx::utils::collectives::tree_binary, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
 
+using nonblocking_hierarchical_broadcast = hpx::utils::collectives::scalar_collective<hpx::utils::collectives::broadcast<hpx::utils::collectives::tree_hierarchical, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_hierarchical_broadcast = hpx::utils::collectives::scalar_collective<hpx::utils::collectives::broadcast<hpx::utils::collectives::tree_hierarchical, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
 // scatter
 //
 using nonblocking_binomial_scatter = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::scatter<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
@@ -91,6 +138,9 @@ using blocking_binomial_scatter = hpx::utils::collectives::iterable_collective<h
 using nonblocking_binary_scatter = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::scatter<hpx::utils::collectives::tree_binary, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
 using blocking_binary_scatter = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::scatter<hpx::utils::collectives::tree_binary, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
 
+using nonblocking_hierarchical_scatter = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::scatter<hpx::utils::collectives::tree_hierarchical, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_hierarchical_scatter = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::scatter<hpx::utils::collectives::tree_hierarchical, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
 // gather
 //
 using nonblocking_binary_gather = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::gather<hpx::utils::collectives::tree_binary, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
@@ -99,6 +149,19 @@ using blocking_binary_gather = hpx::utils::collectives::iterable_collective<hpx:
 using nonblocking_binomial_gather = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::gather<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
 using blocking_binomial_gather = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::gather<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
 
+using nonblocking_hierarchical_gather = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::gather<hpx::utils::collectives::tree_hierarchical, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_hierarchical_gather = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::gather<hpx::utils::collectives::tree_hierarchical, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
+// scatterv
+//
+using nonblocking_binomial_scatterv = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::scatterv<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_binomial_scatterv = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::scatterv<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
+// gatherv
+//
+using nonblocking_binomial_gatherv = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::gatherv<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_binomial_gatherv = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::gatherv<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
 // reduce
 //
 using nonblocking_binary_reduce = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::reduce<hpx::utils::collectives::tree_binary, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
@@ -107,6 +170,41 @@ using blocking_binary_reduce = hpx::utils::collectives::iterable_collective<hpx:
 using nonblocking_binomial_reduce = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::reduce<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
 using blocking_binomial_reduce = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::reduce<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
 
+using nonblocking_hierarchical_reduce = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::reduce<hpx::utils::collectives::tree_hierarchical, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_hierarchical_reduce = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::reduce<hpx::utils::collectives::tree_hierarchical, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
+// allreduce
+//
+using nonblocking_hierarchical_allreduce = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::allreduce<hpx::utils::collectives::tree_hierarchical, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_hierarchical_allreduce = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::allreduce<hpx::utils::collectives::tree_hierarchical, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
+// allgather
+//
+using nonblocking_hypercube_allgather = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::allgather<hpx::utils::collectives::topology_hypercube, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_hypercube_allgather = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::allgather<hpx::utils::collectives::topology_hypercube, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
+using nonblocking_bruck_allgather = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::allgather<hpx::utils::collectives::topology_bruck, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_bruck_allgather = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::allgather<hpx::utils::collectives::topology_bruck, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
+using nonblocking_binomial_allgather = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::allgather<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_binomial_allgather = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::allgather<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
+// scan
+//
+using nonblocking_binomial_scan = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::scan<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_binomial_scan = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::scan<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
+using nonblocking_hypercube_scan = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::scan<hpx::utils::collectives::topology_hypercube, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_hypercube_scan = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::scan<hpx::utils::collectives::topology_hypercube, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
+// exscan
+//
+using nonblocking_binomial_exscan = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::exscan<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_binomial_exscan = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::exscan<hpx::utils::collectives::tree_binomial, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
+using nonblocking_hypercube_exscan = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::exscan<hpx::utils::collectives::topology_hypercube, hpx::utils::collectives::nonblocking, hpx::utils::collectives::serialization::backend>>;
+using blocking_hypercube_exscan = hpx::utils::collectives::iterable_collective<hpx::utils::collectives::exscan<hpx::utils::collectives::topology_hypercube, hpx::utils::collectives::blocking, hpx::utils::collectives::serialization::backend>>;
+
 } /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
 
 #endif
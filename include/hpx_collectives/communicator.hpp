@@ -0,0 +1,236 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_COMMUNICATOR_HPP__
+#define __HPX_COLLECTIVES_COMMUNICATOR_HPP__
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <tuple>
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <numeric>
+#include <algorithm>
+
+#include "transport.hpp"
+#include "mailbox.hpp"
+#include "schedule.hpp"
+#include "utils.hpp"
+
+REGISTER_DISTRIBUTED_OBJECT_PART(std::tuple<std::int32_t, std::int32_t, std::vector<std::string>>);
+REGISTER_DISTRIBUTED_OBJECT_PART(std::tuple<std::int32_t, std::int32_t, std::vector<std::pair<std::int64_t, std::int64_t>>>);
+
+namespace hpx { namespace utils { namespace collectives {
+
+// an ordered group of localities; collectives constructed with one only
+// involve its members, address them by their rank in the group and
+// qualify their mailbox and barrier names with the group's name so
+// disjoint groups can run the same collective concurrently
+//
+// a shared communicator registers a single multiplexed mailbox when it
+// is created; the mailboxes of every collective built on it become
+// slots in that registration, tagged by the collective's qualified agas
+// name. subgroups and splits of a shared communicator reuse the
+// registration, their members being members of it
+//
+// the handler priority is the priority every mailbox attached through
+// the communicator posts at; subgroups and splits inherit it
+//
+class communicator {
+
+    std::string name_;
+    std::shared_ptr< const std::vector<std::int64_t> > ranks_;
+    std::int64_t rank_me_;
+    std::shared_ptr<std::int64_t> splits_;
+    std::shared_ptr<multiplexer_object> mux_;
+    transport::handler_priority priority_;
+
+    communicator(const std::string & name, std::vector<std::int64_t> ranks, const std::int64_t rank_me, std::shared_ptr<multiplexer_object> mux, const transport::handler_priority priority) :
+        name_(name),
+        ranks_(std::make_shared< const std::vector<std::int64_t> >(std::move(ranks))),
+        rank_me_(rank_me),
+        splits_(std::make_shared<std::int64_t>(0)),
+        mux_(std::move(mux)),
+        priority_(priority) {
+    }
+
+    static std::vector<std::int64_t> all_localities() {
+        std::vector<std::int64_t> ranks(transport::rank_n());
+        std::iota(ranks.begin(), ranks.end(), std::int64_t{0});
+        return ranks;
+    }
+
+public:
+    // every locality, in locality order
+    //
+    communicator() :
+        communicator(std::string{}, all_localities(), transport::rank_me(), nullptr, transport::handler_priority::normal) {
+    }
+
+    // every locality, in locality order, sharing one mailbox registration
+    // under agas_name
+    //
+    explicit communicator(const std::string & agas_name) :
+        communicator(agas_name, all_localities(), transport::rank_me(), nullptr, transport::handler_priority::normal) {
+        mux_ = std::make_shared<multiplexer_object>(
+            qualify("mailbox"), std::make_shared<multiplexer>(), members()
+        );
+    }
+
+    bool shared() const { return static_cast<bool>(mux_); }
+
+    transport::handler_priority handler_priority() const { return priority_; }
+
+    // this communicator, with collectives built on the copy posting their
+    // handlers at priority; a collective built on
+    // comm.with_priority(transport::handler_priority::high) keeps moving
+    // on a locality saturated with compute tasks
+    //
+    communicator with_priority(const transport::handler_priority priority) const {
+        communicator copy{*this};
+        copy.priority_ = priority;
+        return copy;
+    }
+
+    const std::string & name() const { return name_; }
+
+    std::int64_t rank_me() const { return rank_me_; }
+
+    std::int64_t rank_n() const { return static_cast<std::int64_t>(ranks_->size()); }
+
+    // locality of every member, indexed by rank in this communicator
+    //
+    const std::vector<std::int64_t> & members() const { return *ranks_; }
+
+    std::int64_t global(const std::int64_t rank) const { return (*ranks_)[rank]; }
+
+    // the world communicator leaves names untouched
+    //
+    std::string qualify(const std::string & agas_name) const {
+        return name_.empty() ? agas_name : (name_ + "/" + agas_name);
+    }
+
+    // rank numbering relative to a root, the numbering every tree in
+    // this library is laid out in
+    //
+    std::int64_t relative(const std::int64_t rank, const std::int64_t root) const {
+        return (rank - root + rank_n()) % rank_n();
+    }
+
+    std::int64_t global_of_relative(const std::int64_t rel, const std::int64_t root) const {
+        return global((rel + root) % rank_n());
+    }
+
+    binomial_schedule schedule() const { return binomial_schedule{rank_n()}; }
+
+    // the mailbox of the collective named agas_name on this communicator
+    //
+    template<typename T>
+    mailbox<T> attach(const std::string & agas_name, T init) const {
+        if(mux_) { return mailbox<T>{mux_, mailbox_tag(qualify(agas_name)), std::move(init), priority_}; }
+        return mailbox<T>{qualify(agas_name), std::move(init), members(), priority_};
+    }
+
+    void barrier() const {
+        transport::barrier b(qualify("wait_for_completion"), rank_n(), rank_me());
+        b.wait(); // make sure communications terminate properly
+    }
+
+    // collective; every member contributes one value and gets back the
+    // values of all members in rank order
+    //
+    template<typename T>
+    std::vector<T> exchange(const std::string & agas_name, const T & value) const {
+        using mailbox_t = std::tuple<std::int32_t, std::int32_t, std::vector<T>>;
+
+        const std::int64_t rank_n_ = rank_n();
+        const binomial_schedule tree = schedule();
+
+        mailbox<mailbox_t> args = attach(agas_name, std::make_tuple(0, 0, std::vector<T>(rank_n_)));
+
+        if(rank_me_ == 0) {
+            std::get<2>(*args)[0] = value;
+            while(__atomic_load_n(&std::get<0>(*args), __ATOMIC_ACQUIRE) < (rank_n_ - 1)) { transport::yield(); }
+        }
+        else {
+            args.post(
+                global(0),
+                [](mailbox<mailbox_t> & args_, std::int64_t rank, T value_) {
+                    std::get<2>(*args_)[rank] = value_;
+                    __atomic_add_fetch( &std::get<0>(*args_), 1, __ATOMIC_ACQ_REL );
+                }, rank_me_, value
+            );
+
+            while(!atomic_xchange( &std::get<1>(*args), 1, 0 )) { transport::yield(); }
+        }
+
+        const auto children = tree.children(rank_me_);
+        for(auto child = children.rbegin(); child != children.rend(); ++child) {
+            args.post(
+                global(child->first),
+                [](mailbox<mailbox_t> & args_, std::vector<T> values) {
+                    std::get<2>(*args_) = values;
+                    atomic_xchange( &std::get<1>(*args_), 0, 1 );
+                }, std::get<2>(*args)
+            );
+        }
+
+        return std::move(std::get<2>(*args));
+    }
+
+    // the members of this communicator at ranks, in that order, as a
+    // communicator named agas_name; nothing is exchanged, so every member
+    // of the group must pass the same ranks, and only members may call it
+    //
+    communicator subgroup(const std::string & agas_name, const std::vector<std::int64_t> & ranks) const {
+        std::vector<std::int64_t> localities(ranks.size());
+        std::int64_t rank_me = -1;
+        for(std::size_t i = 0; i < ranks.size(); ++i) {
+            localities[i] = global(ranks[i]);
+            if(ranks[i] == rank_me_) { rank_me = static_cast<std::int64_t>(i); }
+        }
+
+        if(rank_me < 0) {
+            throw std::invalid_argument("hpx_collectives communicator: subgroup called by a rank outside the group");
+        }
+
+        return communicator{qualify(agas_name), std::move(localities), rank_me, mux_, priority_};
+    }
+
+    // collective over this communicator; members passing the same color
+    // end up in the same communicator, ranked by key and then by their
+    // rank here; every member must split in the same order, and the
+    // result is shared when this communicator is
+    //
+    communicator split(const std::int64_t color, const std::int64_t key) {
+        const std::string split_name = "split" + std::to_string((*splits_)++);
+        const auto table = exchange(split_name, std::make_pair(color, key));
+
+        std::vector<std::int64_t> group{};
+        for(std::int64_t rank = 0; rank < rank_n(); ++rank) {
+            if(table[rank].first == color) { group.push_back(rank); }
+        }
+
+        std::stable_sort(group.begin(), group.end(), [&table](const std::int64_t a, const std::int64_t b) {
+            return table[a].second < table[b].second;
+        });
+
+        std::vector<std::int64_t> ranks(group.size());
+        std::int64_t rank_me = 0;
+        for(std::size_t i = 0; i < group.size(); ++i) {
+            ranks[i] = global(group[i]);
+            if(group[i] == rank_me_) { rank_me = static_cast<std::int64_t>(i); }
+        }
+
+        return communicator{qualify(split_name + "_" + std::to_string(color)), std::move(ranks), rank_me, mux_, priority_};
+    }
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,168 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_COMPRESSION_HPP__
+#define __HPX_COLLECTIVES_COMPRESSION_HPP__
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace hpx { namespace utils { namespace collectives {
+
+// 16 bit floating point wire formats; encode rounds to nearest even
+//
+// fp16: IEEE 754 binary16, 5 exponent bits, 10 mantissa bits; magnitudes
+// past 65504 become infinity
+//
+struct fp16 {
+    static std::uint16_t encode(const float value) {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        const std::uint16_t sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+        std::uint32_t magnitude = bits & 0x7fffffffu;
+
+        // infinity, nan (kept quiet)
+        //
+        if(magnitude >= 0x7f800000u) {
+            return sign | 0x7c00u | ((magnitude > 0x7f800000u) ? 0x0200u : 0u);
+        }
+
+        // 65520 and up round to infinity
+        //
+        if(magnitude >= 0x477ff000u) {
+            return sign | 0x7c00u;
+        }
+
+        // below 2^-14 the result is subnormal, a multiple of 2^-24
+        //
+        if(magnitude < 0x38800000u) {
+            const float scaled = std::fabs(value) * 16777216.0f;
+            return sign | static_cast<std::uint16_t>(std::nearbyint(scaled));
+        }
+
+        // rebias the exponent and round the 13 dropped mantissa bits
+        //
+        const std::uint32_t odd = (magnitude >> 13) & 1u;
+        magnitude += 0xc8000000u + 0x0fffu + odd;
+        return sign | static_cast<std::uint16_t>(magnitude >> 13);
+    }
+
+    static float decode(const std::uint16_t half) {
+        const std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+        const std::uint32_t exponent = (half >> 10) & 0x1fu;
+        const std::uint32_t mantissa = half & 0x03ffu;
+
+        if(exponent == 0) {
+            const float magnitude = static_cast<float>(mantissa) / 16777216.0f;
+            return sign ? -magnitude : magnitude;
+        }
+
+        const std::uint32_t bits = (exponent == 0x1fu) ?
+            (sign | 0x7f800000u | (mantissa << 13)) :
+            (sign | ((exponent + 112u) << 23) | (mantissa << 13));
+
+        float value = 0.0f;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+};
+
+// bf16: the upper half of an IEEE 754 binary32, 8 exponent bits and 7
+// mantissa bits; same range as float, less precision than fp16
+//
+struct bf16 {
+    static std::uint16_t encode(const float value) {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        if((bits & 0x7fffffffu) > 0x7f800000u) {
+            return static_cast<std::uint16_t>((bits >> 16) | 0x0040u);
+        }
+
+        bits += 0x7fffu + ((bits >> 16) & 1u);
+        return static_cast<std::uint16_t>(bits >> 16);
+    }
+
+    static float decode(const std::uint16_t half) {
+        const std::uint32_t bits = static_cast<std::uint32_t>(half) << 16;
+        float value = 0.0f;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+};
+
+// quantizes float or double vectors to Format for the wire; values are
+// rounded to float first
+//
+// with error feedback the rounding error of every element is kept and
+// added to that element the next time this quantizer encodes, so errors
+// do not accumulate across calls (iterations of a training loop, say).
+// keep one quantizer per collective and rank, alive across calls
+//
+template<typename Format>
+class quantizer {
+
+    bool error_feedback;
+    std::vector<double> residual;
+
+public:
+    using format = Format;
+
+    explicit quantizer(const bool error_feedback_=false) :
+        error_feedback(error_feedback_), residual() {
+    }
+
+    template<typename Value>
+    std::vector<std::uint16_t> encode(const std::vector<Value> & values) {
+        static_assert(std::is_floating_point<Value>::value, "quantizer encodes floating point values");
+
+        const std::size_t n = values.size();
+        std::vector<std::uint16_t> wire(n);
+
+        if(!error_feedback) {
+            for(std::size_t i = 0; i < n; ++i) {
+                wire[i] = Format::encode(static_cast<float>(values[i]));
+            }
+            return wire;
+        }
+
+        if(residual.size() != n) {
+            residual.assign(n, 0.0);
+        }
+
+        for(std::size_t i = 0; i < n; ++i) {
+            const double corrected = static_cast<double>(values[i]) + residual[i];
+            wire[i] = Format::encode(static_cast<float>(corrected));
+            const double sent = static_cast<double>(Format::decode(wire[i]));
+            residual[i] = std::isfinite(sent) ? (corrected - sent) : 0.0;
+        }
+
+        return wire;
+    }
+
+    template<typename Value>
+    std::vector<Value> decode(const std::vector<std::uint16_t> & wire) const {
+        std::vector<Value> values(wire.size());
+        for(std::size_t i = 0; i < wire.size(); ++i) {
+            values[i] = static_cast<Value>(Format::decode(wire[i]));
+        }
+        return values;
+    }
+
+    // drops the carried error, when the vector being reduced changes
+    //
+    void reset() {
+        residual.clear();
+    }
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,262 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_DELTA_HPP__
+#define __HPX_COLLECTIVES_DELTA_HPP__
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace hpx { namespace utils { namespace collectives { namespace delta {
+
+// byte strings encoded against a base both ends hold, for broadcasting a
+// value that changes little between calls
+//
+// the sender cuts base and target into content defined chunks with a
+// gear rolling hash (boundaries follow the bytes, not their offsets, so
+// an insertion only disturbs the chunks around it) and sends every chunk
+// of target that also occurs in base as a copy of base's bytes, and
+// everything else literally. the sender compares the bytes of every
+// match, so a hash collision never corrupts the result; the receiver
+// only replays the copies and literals against its own base
+//
+// message formats, after one kind byte and the target's hash and size:
+//
+//     unchanged  nothing, target is base
+//     edits      ops, each a copy (offset, length) into base or a
+//                literal (length, bytes)
+//     full       the target's bytes
+//
+
+enum kind : char { unchanged = 0, edits = 1, full = 2 };
+enum op : char { copy = 0, literal = 1 };
+
+// FNV-1a; every locality runs the same binary
+//
+static inline std::uint64_t hash(const char * data, const std::size_t len) {
+    std::uint64_t h = 14695981039346656037ull;
+    for(std::size_t i = 0; i < len; ++i) {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// chunks average about 2^avg_bits bytes, never shorter than min_bytes
+// unless the input ends, never longer than max_bytes
+//
+struct chunking {
+    std::size_t min_bytes = 256;
+    std::uint32_t avg_bits = 11;
+    std::size_t max_bytes = 16384;
+};
+
+namespace detail {
+
+// splitmix64, so the gear table is the same on every build
+//
+static constexpr std::array<std::uint64_t, 256> gear_table() {
+    std::array<std::uint64_t, 256> table{};
+    std::uint64_t state = 0x9e3779b97f4a7c15ull;
+    for(std::size_t i = 0; i < table.size(); ++i) {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        table[i] = z ^ (z >> 31);
+    }
+    return table;
+}
+
+static constexpr std::array<std::uint64_t, 256> gear = gear_table();
+
+template<typename T>
+void put(std::string & out, const T value) {
+    const std::size_t at = out.size();
+    out.resize(at + sizeof(T));
+    std::memcpy(&out[at], &value, sizeof(T));
+}
+
+template<typename T>
+T get(const std::string & in, std::size_t & at) {
+    if(at + sizeof(T) > in.size()) {
+        throw std::runtime_error("hpx_collectives delta: truncated message");
+    }
+    T value{};
+    std::memcpy(&value, in.data() + at, sizeof(T));
+    at += sizeof(T);
+    return value;
+}
+
+} /* end namespace detail */
+
+// (offset, length) of the content defined chunks of data, in order
+//
+static inline std::vector< std::pair<std::size_t, std::size_t> > chunks(const std::string & data, const chunking & params = chunking{}) {
+    std::vector< std::pair<std::size_t, std::size_t> > cuts{};
+    const std::uint64_t mask = (std::uint64_t{1} << params.avg_bits) - 1;
+
+    std::size_t first = 0;
+    while(first < data.size()) {
+        const std::size_t last = std::min(data.size(), first + params.max_bytes);
+        std::size_t end = last;
+        std::uint64_t h = 0;
+
+        for(std::size_t i = first; i < last; ++i) {
+            h = (h << 1) + detail::gear[static_cast<unsigned char>(data[i])];
+            if((i + 1 - first) >= params.min_bytes && (h & mask) == 0) {
+                end = i + 1;
+                break;
+            }
+        }
+
+        cuts.emplace_back(first, end - first);
+        first = end;
+    }
+
+    return cuts;
+}
+
+// target as a message against base
+//
+static inline std::string encode(const std::string & base, const std::string & target, const chunking & params = chunking{}) {
+    std::string message{};
+    message.push_back((target == base) ? unchanged : edits);
+    detail::put(message, hash(target.data(), target.size()));
+    detail::put(message, static_cast<std::uint64_t>(target.size()));
+
+    if(message[0] == unchanged) { return message; }
+
+    // chunks of base by hash and length; the first occurrence wins
+    //
+    std::unordered_map<std::uint64_t, std::pair<std::size_t, std::size_t> > known{};
+    for(const auto & chunk : chunks(base, params)) {
+        known.emplace(hash(base.data() + chunk.first, chunk.second) ^ chunk.second, chunk);
+    }
+
+    const std::size_t header = message.size();
+    std::size_t literal_first = 0, literal_n = 0;
+    std::size_t copy_first = 0, copy_n = 0;
+
+    const auto flush_literal = [&]() {
+        if(literal_n == 0) { return; }
+        message.push_back(literal);
+        detail::put(message, static_cast<std::uint64_t>(literal_n));
+        message.append(target, literal_first, literal_n);
+        literal_n = 0;
+    };
+
+    const auto flush_copy = [&]() {
+        if(copy_n == 0) { return; }
+        message.push_back(copy);
+        detail::put(message, static_cast<std::uint64_t>(copy_first));
+        detail::put(message, static_cast<std::uint64_t>(copy_n));
+        copy_n = 0;
+    };
+
+    for(const auto & chunk : chunks(target, params)) {
+        const auto itr = known.find(hash(target.data() + chunk.first, chunk.second) ^ chunk.second);
+        const bool match = itr != known.end() && itr->second.second == chunk.second &&
+            base.compare(itr->second.first, chunk.second, target, chunk.first, chunk.second) == 0;
+
+        if(match) {
+            flush_literal();
+            if(copy_n > 0 && copy_first + copy_n == itr->second.first) {
+                copy_n += chunk.second;
+            }
+            else {
+                flush_copy();
+                copy_first = itr->second.first;
+                copy_n = chunk.second;
+            }
+        }
+        else {
+            flush_copy();
+            if(literal_n == 0) { literal_first = chunk.first; }
+            literal_n += chunk.second;
+        }
+    }
+
+    flush_literal();
+    flush_copy();
+
+    // nothing worth copying; ship the bytes
+    //
+    if(message.size() - header >= target.size()) {
+        message.resize(header);
+        message[0] = full;
+        message.append(target);
+    }
+
+    return message;
+}
+
+// the target a message was encoded for, rebuilt against base; throws if
+// the result does not hash to the target's hash, which means base is not
+// the base the sender encoded against
+//
+static inline std::string decode(const std::string & base, const std::string & message) {
+    std::size_t at = 0;
+    const char type = detail::get<char>(message, at);
+    const std::uint64_t target_hash = detail::get<std::uint64_t>(message, at);
+    const std::uint64_t target_n = detail::get<std::uint64_t>(message, at);
+
+    std::string target{};
+    if(type == unchanged) {
+        target = base;
+    }
+    else if(type == full) {
+        target = message.substr(at);
+    }
+    else {
+        target.reserve(target_n);
+        while(at < message.size()) {
+            const char operation = detail::get<char>(message, at);
+            if(operation == copy) {
+                const std::uint64_t offset = detail::get<std::uint64_t>(message, at);
+                const std::uint64_t len = detail::get<std::uint64_t>(message, at);
+                if(offset + len > base.size()) {
+                    throw std::runtime_error("hpx_collectives delta: copy past the end of the base");
+                }
+                target.append(base, offset, len);
+            }
+            else {
+                const std::uint64_t len = detail::get<std::uint64_t>(message, at);
+                if(at + len > message.size()) {
+                    throw std::runtime_error("hpx_collectives delta: truncated message");
+                }
+                target.append(message, at, len);
+                at += len;
+            }
+        }
+    }
+
+    if(target.size() != target_n || hash(target.data(), target.size()) != target_hash) {
+        throw std::runtime_error("hpx_collectives delta: result does not match the sender's, the bases differ");
+    }
+
+    return target;
+}
+
+} /* end namespace delta */
+
+// call option of the tree broadcasts: the value goes out as a delta
+// against the value of the previous incremental call; chunks only
+// matters on the root
+//
+struct incremental {
+    delta::chunking chunks{};
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
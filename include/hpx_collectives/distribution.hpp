@@ -0,0 +1,104 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_DISTRIBUTION_HPP__
+#define __HPX_COLLECTIVES_DISTRIBUTION_HPP__
+
+#include <vector>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+
+namespace hpx { namespace utils { namespace collectives {
+
+// how scatterv splits n elements over rank_n ranks when no counts are
+// given; a policy provides counts(n, rank_n)
+//
+// balanced: every rank gets n / rank_n elements and the first
+// n % rank_n ranks one more, so block sizes differ by at most one
+//
+struct balanced_distribution {
+    std::vector<std::int64_t> counts(const std::int64_t n, const std::int64_t rank_n) const {
+        std::vector<std::int64_t> counts_(rank_n, n / rank_n);
+        for(std::int64_t rank = 0; rank < (n % rank_n); ++rank) { ++counts_[rank]; }
+        return counts_;
+    }
+};
+
+// chunk sizes for self-scheduling (scatter_dynamic); a policy provides
+// reset(n, rank_n), called once per call before the first chunk, and
+// next(remaining), the size of the next chunk handed out while remaining
+// elements are left. chunks never drop below min_chunk elements, except
+// the last one
+//
+// fixed: every chunk has chunk elements
+//
+struct fixed_chunks {
+    std::int64_t chunk = 1;
+
+    void reset(const std::int64_t, const std::int64_t) {
+    }
+
+    std::int64_t next(const std::int64_t remaining) const {
+        return std::min(std::max(chunk, std::int64_t{1}), remaining);
+    }
+};
+
+// guided (Polychronopoulos and Kuck): every chunk is remaining / rank_n,
+// so chunks shrink as the work runs out and the last ones even out the
+// finishing times
+//
+struct guided_chunks {
+    std::int64_t min_chunk = 1;
+    std::int64_t rank_n = 1;
+
+    void reset(const std::int64_t, const std::int64_t rank_n_) {
+        rank_n = std::max(rank_n_, std::int64_t{1});
+    }
+
+    std::int64_t next(const std::int64_t remaining) const {
+        return std::min(std::max((remaining + rank_n - 1) / rank_n, std::max(min_chunk, std::int64_t{1})), remaining);
+    }
+};
+
+// factoring (Hummel, Schonberg and Flynn): work is handed out in batches
+// of rank_n equal chunks, each batch covering half of what is left, so
+// chunk sizes halve batch by batch instead of shrinking with every chunk
+//
+struct factoring_chunks {
+    std::int64_t min_chunk = 1;
+    std::int64_t rank_n = 1;
+    std::int64_t batch_left = 0;
+    std::int64_t batch_chunk = 0;
+
+    void reset(const std::int64_t, const std::int64_t rank_n_) {
+        rank_n = std::max(rank_n_, std::int64_t{1});
+        batch_left = 0;
+    }
+
+    std::int64_t next(const std::int64_t remaining) {
+        if(batch_left == 0) {
+            batch_chunk = std::max((remaining + (2 * rank_n) - 1) / (2 * rank_n), std::max(min_chunk, std::int64_t{1}));
+            batch_left = rank_n;
+        }
+        --batch_left;
+        return std::min(batch_chunk, remaining);
+    }
+};
+
+// offset of every block when the blocks are laid out back to back
+//
+static inline std::vector<std::int64_t> displacements(const std::vector<std::int64_t> & counts) {
+    std::vector<std::int64_t> displs(counts.size(), 0);
+    if(!counts.empty()) {
+        std::partial_sum(counts.begin(), counts.end() - 1, displs.begin() + 1);
+    }
+    return displs;
+}
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,93 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_EXSCAN_HPP__
+#define __HPX_EXSCAN_HPP__
+
+#include <string>
+#include <vector>
+#include <numeric>
+#include <iterator>
+#include <algorithm>
+
+#include "collective_traits.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "prefix.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// exclusive prefix in rank order: rank r gets the combination of the
+// inputs of ranks 0 through r - 1, and rank 0 gets init;
+// CommunicationPattern is topology_hypercube (recursive doubling) or
+// tree_binomial (up and down sweep)
+//
+template< typename CommunicationPattern, typename BlockingPolicy, typename Serialization >
+class exscan {
+
+private:
+    prefix::engine< CommunicationPattern, Serialization > prefix_op;
+
+public:
+    using communication_pattern = CommunicationPattern;
+    using blocking_policy = BlockingPolicy;
+
+    exscan(const std::string agas_name) :
+        exscan(agas_name, communicator{}) {
+    }
+
+    exscan(const std::string agas_name, const communicator & comm_) :
+        prefix_op(agas_name, comm_) {
+    }
+
+    template<typename InputIterator, typename BinaryOp>
+    void operator()(InputIterator input_beg, InputIterator input_end, typename std::iterator_traits<InputIterator>::value_type init, BinaryOp op, typename std::iterator_traits<InputIterator>::value_type & output) {
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        value_type inclusive{};
+        if(!prefix_op(std::accumulate(input_beg, input_end, init, op), op, inclusive, output)) {
+            output = init;
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            prefix_op.get_communicator().barrier();
+        }
+    }
+
+    // element-wise; every rank passes the same number of elements and
+    // output_beg[i] gets the prefix of element i across lower ranks
+    //
+    template<typename InputIterator, typename OutputIterator, typename BinaryOp>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator output_beg, typename std::iterator_traits<InputIterator>::value_type init, BinaryOp op) {
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        std::vector<value_type> local(std::distance(input_beg, input_end));
+        std::transform(input_beg, input_end, local.begin(), [&init, &op](const value_type & element) { return op(init, element); });
+
+        std::vector<value_type> inclusive{}, exclusive{};
+        const bool has_exclusive = prefix_op(local, [&op](std::vector<value_type> lhs, const std::vector<value_type> & rhs) {
+            std::transform(lhs.begin(), lhs.end(), rhs.begin(), lhs.begin(), op);
+            return lhs;
+        }, inclusive, exclusive);
+
+        if(has_exclusive) {
+            std::copy(exclusive.begin(), exclusive.end(), output_beg);
+        }
+        else {
+            std::fill_n(output_beg, local.size(), init);
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            prefix_op.get_communicator().barrier();
+        }
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
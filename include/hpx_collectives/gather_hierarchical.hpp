@@ -0,0 +1,140 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_GATHER_HIERARCHICAL_HPP__
+#define __HPX_GATHER_HIERARCHICAL_HPP__
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <unistd.h>
+
+#include "collective_traits.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "node_map.hpp"
+#include "hierarchical.hpp"
+#include "gather.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+template< typename BlockingPolicy, typename Serialization >
+class gather< tree_hierarchical, BlockingPolicy, Serialization > {
+
+    using value_type_t = typename Serialization::value_type;
+    using serializer_t = typename Serialization::serializer;
+    using deserializer_t = typename Serialization::deserializer;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    node_map nodes;
+    mailbox< hierarchical::mailbox_t > args;
+
+public:
+    using communication_pattern = hpx::utils::collectives::tree_hierarchical;
+    using blocking_policy = BlockingPolicy;
+
+    gather(const std::string agas_name, const std::int64_t root_=0) :
+        gather(agas_name, communicator{}, root_) {
+    }
+
+    gather(const std::string agas_name, const node_map & nodes_, const std::int64_t root_=0) :
+        gather(agas_name, communicator{}, nodes_, root_) {
+    }
+
+    gather(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0) :
+        gather(agas_name, comm_, node_map{agas_name + "_node_map", comm_}, root_) {
+    }
+
+    // root and the ranks in nodes are ranks in comm_
+    //
+    gather(const std::string agas_name, const communicator & comm_, const node_map & nodes_, const std::int64_t root_=0) :
+        root(root_),
+        comm(comm_),
+        nodes(nodes_),
+        args{comm.attach(agas_name, hierarchical::make_mailbox(nodes.members(nodes.node_of(comm.rank_me())).size()))} {
+    }
+
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg) {
+        const std::int64_t rank_me = comm.rank_me();
+        const std::int64_t iter_diff = (input_end - input_beg);
+        const hierarchical::schedule sched{nodes, root};
+
+        // blocks travel as (rank, count, elements...) and are only
+        // unpacked at the root; leaders just concatenate them
+        //
+        std::string block{};
+        if(rank_me != root) {
+            value_type_t value_buffer{};
+            serializer_t value_oa{value_buffer};
+
+            value_oa << rank_me << iter_diff;
+            for(auto seg_itr = input_beg; seg_itr != input_end; ++seg_itr) {
+                value_oa << (*seg_itr);
+            }
+
+            block = Serialization::get_buffer(value_buffer);
+        }
+
+        if(!sched.is_leader(rank_me)) {
+            hierarchical::post_local(comm, args, sched.leader_of(rank_me), nodes.local_index(rank_me), std::move(block));
+        }
+        else {
+            const auto & members = nodes.members(nodes.node_of(rank_me));
+            hierarchical::wait_local(args, static_cast<std::int32_t>(members.size() - 1));
+
+            std::vector<std::string> blocks{};
+            if(rank_me != root) { blocks.push_back(std::move(block)); }
+
+            for(const auto member : members) {
+                if(member != rank_me) {
+                    blocks.push_back(std::move(std::get<3>(*args)[nodes.local_index(member)]));
+                }
+            }
+
+            const std::int64_t rel = sched.relative(rank_me);
+            for(const auto & child : sched.children(rel)) {
+                auto child_blocks = hierarchical::wait_tree(args, child.second);
+                blocks.insert(blocks.end(), std::make_move_iterator(child_blocks.begin()), std::make_move_iterator(child_blocks.end()));
+            }
+
+            if(rel != 0) {
+                std::int64_t round = 0;
+                const std::int64_t parent = sched.parent(rel, round);
+                hierarchical::post_tree(comm, args, sched.leader_of_relative(parent), round, std::move(blocks));
+            }
+            else {
+                std::copy(input_beg, input_end, out_beg + (rank_me * iter_diff));
+
+                for(auto & recv_str : blocks) {
+                    std::int64_t in_rank = 0, in_count = 0;
+                    value_type_t value_buffer{recv_str};
+                    deserializer_t iarch{value_buffer};
+
+                    iarch >> in_rank >> in_count;
+                    for(std::int64_t count = 0; count < in_count; ++count) {
+                        iarch >> (*(out_beg + ((in_rank * in_count) + count)));
+                    }
+                }
+            }
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+    } // end operator()
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
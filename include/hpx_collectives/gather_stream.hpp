@@ -0,0 +1,236 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_GATHER_STREAM_HPP__
+#define __HPX_GATHER_STREAM_HPP__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "collective_traits.hpp"
+#include "stream_sink.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "slots.hpp"
+#include "utils.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// gathers ValueType records into an output iterator or a sink (a
+// mapped_output_file, a file_writer or any byte sink) on the root, in
+// rank order, as they arrive; nothing is accumulated on the way
+//
+// the root pulls: it grants a rank one chunk at a time and never has
+// more than inflight_bytes of chunks granted and not yet written, so
+// senders wait on the root's pace and the root's memory stays bounded
+// whatever the size of the gathered data
+//
+// records are copied as raw bytes, so ValueType must be trivially
+// copyable
+//
+template< typename ValueType, typename BlockingPolicy >
+class gather_stream {
+
+    static_assert(std::is_trivially_copyable<ValueType>::value, "gather_stream moves records as raw bytes");
+
+    using mailbox_t = slots::mailbox_t<std::string>;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    std::int64_t chunk_n, window;
+    mailbox<mailbox_t> args;
+
+    // slots 0 .. window - 1: chunks on the root, by grant number modulo window
+    // slots window .. 2 window - 1: grants on the senders, by chunk number modulo window
+    // slots 2 window ..: record count of every rank, on the root
+    //
+    std::int64_t grant_slot(const std::int64_t chunk) const { return window + (chunk % window); }
+    std::int64_t count_slot(const std::int64_t rank) const { return (2 * window) + rank; }
+
+    static std::string encode(const std::int64_t value) {
+        std::string data(sizeof(std::int64_t), '\0');
+        std::memcpy(&data[0], &value, sizeof(std::int64_t));
+        return data;
+    }
+
+    static std::int64_t decode(const std::string & data) {
+        std::int64_t value = 0;
+        std::memcpy(&value, data.data(), sizeof(std::int64_t));
+        return value;
+    }
+
+    template<typename InputIterator>
+    static std::string fill(InputIterator & input_itr, const std::int64_t records) {
+        std::string chunk(records * sizeof(ValueType), '\0');
+        for(std::int64_t i = 0; i < records; ++i, ++input_itr) {
+            const ValueType value = *input_itr;
+            std::memcpy(&chunk[i * sizeof(ValueType)], &value, sizeof(ValueType));
+        }
+        return chunk;
+    }
+
+    std::int64_t chunks_of(const std::int64_t records) const {
+        return (records + chunk_n - 1) / chunk_n;
+    }
+
+    template<typename InputIterator>
+    void send(InputIterator input_beg, InputIterator input_end) {
+        const std::int64_t rank_root = comm.global(root);
+        const std::int64_t records = static_cast<std::int64_t>(std::distance(input_beg, input_end));
+
+        slots::post(args, rank_root, count_slot(comm.rank_me()), encode(records));
+
+        for(std::int64_t chunk = 0, first = 0; first < records; ++chunk, first += chunk_n) {
+            const std::int64_t slot = decode(slots::wait(args, grant_slot(chunk)));
+            slots::post(args, rank_root, slot, fill(input_beg, std::min(chunk_n, records - first)));
+        }
+    }
+
+    // write(data, records) receives every chunk in rank order
+    //
+    template<typename InputIterator, typename Reserve, typename Write>
+    void receive(InputIterator input_beg, InputIterator input_end, Reserve && reserve, Write && write) {
+        const std::int64_t rank_n = comm.rank_n();
+
+        std::vector<std::int64_t> counts(rank_n, 0);
+        for(std::int64_t rank = 0; rank < rank_n; ++rank) {
+            counts[rank] = (rank == root) ?
+                static_cast<std::int64_t>(std::distance(input_beg, input_end)) :
+                decode(slots::wait(args, count_slot(rank)));
+        }
+
+        reserve(std::accumulate(counts.begin(), counts.end(), std::int64_t{0}) * static_cast<std::int64_t>(sizeof(ValueType)));
+
+        // plan[i] is the rank and chunk number of the i-th chunk written
+        //
+        std::vector< std::pair<std::int64_t, std::int64_t> > plan{};
+        for(std::int64_t rank = 0; rank < rank_n; ++rank) {
+            for(std::int64_t chunk = 0; chunk < chunks_of(counts[rank]); ++chunk) {
+                plan.emplace_back(rank, chunk);
+            }
+        }
+
+        const std::int64_t plan_n = static_cast<std::int64_t>(plan.size());
+        std::int64_t granted = 0;
+
+        for(std::int64_t written = 0; written < plan_n; ++written) {
+            // chunk slot granted % window was freed when chunk
+            // granted - window was written
+            //
+            for(; granted < plan_n && (granted - written) < window; ++granted) {
+                const auto & next = plan[granted];
+                if(next.first != root) {
+                    slots::post(args, comm.global(next.first), grant_slot(next.second), encode(granted % window));
+                }
+            }
+
+            const auto & current = plan[written];
+            const std::int64_t records = std::min(chunk_n, counts[current.first] - (current.second * chunk_n));
+
+            if(current.first == root) {
+                const std::string chunk = fill(input_beg, records);
+                write(chunk.data(), records);
+            }
+            else {
+                const std::string chunk = slots::wait(args, written % window);
+                write(chunk.data(), records);
+            }
+        }
+    }
+
+public:
+    using blocking_policy = BlockingPolicy;
+
+    gather_stream(const std::string agas_name, const std::int64_t root_=0) :
+        gather_stream(agas_name, communicator{}, root_) {
+    }
+
+    // root is a rank in comm_; chunk_bytes and inflight_bytes must agree
+    // on every rank
+    //
+    gather_stream(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0, const std::int64_t chunk_bytes=(1 << 20), const std::int64_t inflight_bytes=(8 << 20)) :
+        root(root_),
+        comm(comm_),
+        chunk_n(std::max(chunk_bytes / static_cast<std::int64_t>(sizeof(ValueType)), std::int64_t{1})),
+        window(std::max(inflight_bytes / (chunk_n * static_cast<std::int64_t>(sizeof(ValueType))), std::int64_t{1})),
+        args{comm.attach(agas_name, slots::make_mailbox<std::string>((2 * window) + comm.rank_n()))} {
+    }
+
+    // the root writes the records of every rank to out_beg in rank order;
+    // other ranks may pass any output, it is not touched
+    //
+    template<typename InputIterator, typename OutputIterator>
+    std::enable_if_t< !is_stream_sink<OutputIterator>::value > operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg) {
+        if(comm.rank_me() == root) {
+            receive(input_beg, input_end,
+                [](const std::int64_t) {},
+                [&out_beg](const char * data, const std::int64_t records) {
+                    for(std::int64_t i = 0; i < records; ++i, ++out_beg) {
+                        ValueType value;
+                        std::memcpy(&value, data + (i * sizeof(ValueType)), sizeof(ValueType));
+                        *out_beg = value;
+                    }
+                }
+            );
+        }
+        else {
+            send(input_beg, input_end);
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+    // the root writes the records of every rank to sink in rank order
+    //
+    template<typename InputIterator, typename Sink>
+    std::enable_if_t< is_stream_sink<Sink>::value > operator()(InputIterator input_beg, InputIterator input_end, Sink & sink) {
+        if(comm.rank_me() == root) {
+            receive(input_beg, input_end,
+                [&sink](const std::int64_t bytes) { sink.reserve(bytes); },
+                [&sink](const char * data, const std::int64_t records) {
+                    sink.write(data, records * static_cast<std::int64_t>(sizeof(ValueType)));
+                }
+            );
+        }
+        else {
+            send(input_beg, input_end);
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+    // every rank but the root
+    //
+    template<typename InputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end) {
+        if(comm.rank_me() == root) {
+            throw std::logic_error("hpx_collectives gather_stream: the root must pass an output");
+        }
+
+        send(input_beg, input_end);
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,117 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_GATHER_TREE_HPP__
+#define __HPX_GATHER_TREE_HPP__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+
+#include "collective_traits.hpp"
+#include "gather.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "schedule.hpp"
+#include "slots.hpp"
+#include "packed_blocks.hpp"
+
+namespace hpx { namespace utils { namespace collectives { namespace tree {
+
+// every rank packs its block once; a node appends its children's
+// buffers to its own, in the schedule's buffer order, and sends its
+// parent one buffer. blocks are only deserialized on the root
+//
+template< typename Schedule, typename BlockingPolicy, typename Serialization >
+class gather {
+
+    using mailbox_t = slots::mailbox_t<packed_blocks>;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    mailbox<mailbox_t> args;
+
+public:
+    using blocking_policy = BlockingPolicy;
+
+    gather(const std::string agas_name, const std::int64_t root_=0) :
+        gather(agas_name, communicator{}, root_) {
+    }
+
+    // root is a rank in comm_
+    //
+    gather(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0) :
+        root(root_),
+        comm(comm_),
+        args{comm.attach(agas_name, slots::make_mailbox<packed_blocks>(Schedule{comm.rank_n()}.slot_n()))} {
+    }
+
+    // the root writes every rank's block to out_beg, in rank order
+    //
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg) {
+        // https://en.cppreference.com/w/cpp/header/iterator
+        //
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        const std::int64_t rank_n = comm.rank_n();
+        const std::int64_t rank_me = comm.relative(comm.rank_me(), root);
+        const Schedule tree{rank_n};
+
+        packed_blocks blocks{};
+        blocks.append<Serialization>(input_beg, input_end);
+
+        for(const auto & child : tree.children(rank_me)) {
+            blocks.append(slots::wait(args, child.second));
+        }
+
+        if(rank_me != 0) {
+            std::int64_t slot = 0;
+            const std::int64_t parent = tree.parent(rank_me, slot);
+            std::move(blocks).post(args, comm.global_of_relative(parent, root), slot);
+        }
+        else {
+            // position of every relative rank's block in the buffer
+            //
+            const std::vector<std::int64_t> order = tree.order(0);
+            std::vector<std::int64_t> position(rank_n);
+            for(std::int64_t i = 0; i < rank_n; ++i) { position[order[i]] = i; }
+
+            for(std::int64_t rank = 0; rank < rank_n; ++rank) {
+                out_beg = blocks.unpack<Serialization, value_type>(position[comm.relative(rank, root)], out_beg);
+            }
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+    } // end operator()
+
+};
+
+} /* end namespace tree */
+
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class gather< tree_knomial<K>, BlockingPolicy, Serialization > : public tree::gather< knomial_schedule<K>, BlockingPolicy, Serialization > {
+public:
+    using communication_pattern = tree_knomial<K>;
+    using tree::gather< knomial_schedule<K>, BlockingPolicy, Serialization >::gather;
+};
+
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class gather< tree_kary<K>, BlockingPolicy, Serialization > : public tree::gather< kary_schedule<K>, BlockingPolicy, Serialization > {
+public:
+    using communication_pattern = tree_kary<K>;
+    using tree::gather< kary_schedule<K>, BlockingPolicy, Serialization >::gather;
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,33 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_GATHERV_HPP__
+#define __HPX_GATHERV_HPP__
+
+#include <vector>
+#include <cstdint>
+
+#include "collective_traits.hpp" 
+#include "distribution.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+template< typename CommunicationPattern, typename BlockingPolicy, typename Serialization >
+class gatherv {
+public:
+    using communication_pattern = CommunicationPattern;
+    using blocking_policy = BlockingPolicy;
+
+    gatherv(const std::int64_t root_=0);
+
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, const std::vector<std::int64_t> & counts, const std::vector<std::int64_t> & displs, OutputIterator out_beg);
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+
+#endif
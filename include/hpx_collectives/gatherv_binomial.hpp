@@ -0,0 +1,147 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_GATHERV_BINOMIAL_HPP__
+#define __HPX_GATHERV_BINOMIAL_HPP__
+
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+#include "collective_traits.hpp"
+#include "gatherv.hpp"
+#include "distribution.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "slots.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// every rank packs its block once and the blocks of a binomial subtree
+// travel to its parent as one message, so each link carries exactly the
+// bytes of the subtree below it
+//
+template< typename BlockingPolicy, typename Serialization >
+class gatherv< tree_binomial, BlockingPolicy, Serialization > {
+
+    using mailbox_t = slots::mailbox_t< std::vector<std::string> >;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    mailbox<mailbox_t> args;
+
+    // blocks indexed by relative rank on the root, empty elsewhere
+    //
+    std::vector<std::string> collect(std::string block) {
+        const std::int64_t rank_me = comm.relative(comm.rank_me(), root);
+        const binomial_schedule tree = comm.schedule();
+
+        // children are nearest first, so appending keeps relative rank order
+        //
+        std::vector<std::string> blocks{};
+        blocks.reserve(tree.subtree_n(rank_me));
+        blocks.push_back(std::move(block));
+
+        for(const auto & child : tree.children(rank_me)) {
+            std::vector<std::string> recv = slots::wait(args, child.second);
+            std::move(recv.begin(), recv.end(), std::back_inserter(blocks));
+        }
+
+        if(rank_me != 0) {
+            std::int64_t round = 0;
+            const std::int64_t parent = tree.parent(rank_me, round);
+            slots::post(args, comm.global_of_relative(parent, root), round, std::move(blocks));
+            blocks.clear();
+        }
+
+        return blocks;
+    }
+
+public:
+    using communication_pattern = hpx::utils::collectives::tree_binomial;
+    using blocking_policy = BlockingPolicy;
+
+    gatherv(const std::string agas_name, const std::int64_t root_=0) :
+        gatherv(agas_name, communicator{}, root_) {
+    }
+
+    // root is a rank in comm_
+    //
+    gatherv(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0) :
+        root(root_),
+        comm(comm_),
+        args{comm.attach(agas_name, slots::make_mailbox< std::vector<std::string> >(slots::rounds(comm.rank_n())))} {
+    }
+
+    // the root writes rank r's block, which must hold counts[r] elements,
+    // to out_beg + displs[r]; counts and displs are only read on the root
+    //
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, const std::vector<std::int64_t> & counts, const std::vector<std::int64_t> & displs, OutputIterator out_beg) {
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        const std::int64_t rank_n = comm.rank_n();
+        const std::vector<std::string> blocks = collect(serialization::pack_range<Serialization>(input_beg, input_end));
+
+        if(comm.rank_me() == root) {
+            if(static_cast<std::int64_t>(counts.size()) != rank_n || static_cast<std::int64_t>(displs.size()) != rank_n) {
+                throw std::length_error("hpx_collectives gatherv: one count and displacement per rank expected");
+            }
+
+            for(std::int64_t rank = 0; rank < rank_n; ++rank) {
+                if(counts[rank] < 0 || displs[rank] < 0) {
+                    throw std::length_error("hpx_collectives gatherv: negative count or displacement");
+                }
+            }
+
+            // each block is checked against its count before it is
+            // written, so a long block never overruns the next one
+            //
+            std::vector<value_type> block{};
+            for(std::int64_t rank = 0; rank < rank_n; ++rank) {
+                block.clear();
+                serialization::unpack_range<Serialization, value_type>(blocks[comm.relative(rank, root)], std::back_inserter(block));
+                if(static_cast<std::int64_t>(block.size()) != counts[rank]) {
+                    throw std::length_error("hpx_collectives gatherv: block length differs from counts");
+                }
+                std::move(block.begin(), block.end(), out_beg + displs[rank]);
+            }
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+    // blocks of any length, written back to back in rank order
+    //
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg) {
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        const std::int64_t rank_n = comm.rank_n();
+        const std::vector<std::string> blocks = collect(serialization::pack_range<Serialization>(input_beg, input_end));
+
+        if(comm.rank_me() == root) {
+            for(std::int64_t rank = 0; rank < rank_n; ++rank) {
+                out_beg = serialization::unpack_range<Serialization, value_type>(blocks[comm.relative(rank, root)], out_beg);
+            }
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,131 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_HIERARCHICAL_HPP__
+#define __HPX_COLLECTIVES_HIERARCHICAL_HPP__
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "node_map.hpp"
+#include "utils.hpp"
+
+REGISTER_DISTRIBUTED_OBJECT_PART(std::tuple<std::int32_t, std::vector<std::string>, std::int32_t, std::vector<std::string>, std::int64_t, std::vector<std::vector<std::string>>>);
+
+namespace hpx { namespace utils { namespace collectives { namespace hierarchical {
+
+// 0: down flag
+// 1: down payload, from the parent leader or from the node leader
+// 2: number of node members that have posted
+// 3: one payload per node member, indexed by node_map::local_index
+// 4: one bit per leader tree round that has posted
+// 5: one payload per leader tree round
+//
+using mailbox_t = std::tuple< std::int32_t, std::vector<std::string>, std::int32_t, std::vector<std::string>, std::int64_t, std::vector< std::vector<std::string> > >;
+
+static inline mailbox_t make_mailbox(const std::int64_t local_n) {
+    return std::make_tuple(0, std::vector<std::string>{}, 0, std::vector<std::string>(local_n), std::int64_t{0}, std::vector< std::vector<std::string> >(64));
+}
+
+// two-level schedule for one root: node leaders form a binomial tree,
+// indexed relative to the root's node, and every leader talks to the
+// members of its own node directly
+//
+class schedule {
+
+    const node_map & nodes;
+    std::int64_t root, root_node, node_n;
+    binomial_schedule tree;
+
+public:
+    schedule(const node_map & nodes_, const std::int64_t root_) :
+        nodes(nodes_),
+        root(root_),
+        root_node(nodes_.node_of(root_)),
+        node_n(nodes_.node_n()),
+        tree(nodes_.node_n()) {
+    }
+
+    std::int64_t leader_n() const { return node_n; }
+
+    std::int64_t node_of_relative(const std::int64_t rel) const { return (rel + root_node) % node_n; }
+
+    std::int64_t relative(const std::int64_t rank) const { return (nodes.node_of(rank) - root_node + node_n) % node_n; }
+
+    std::int64_t leader_of(const std::int64_t rank) const { return nodes.leader(nodes.node_of(rank), root); }
+
+    std::int64_t leader_of_relative(const std::int64_t rel) const { return nodes.leader(node_of_relative(rel), root); }
+
+    bool is_leader(const std::int64_t rank) const { return leader_of(rank) == rank; }
+
+    // leader tree rounds, by relative leader
+    //
+    std::int64_t parent(const std::int64_t rel, std::int64_t & round) const { return tree.parent(rel, round); }
+
+    std::vector< std::pair<std::int64_t, std::int64_t> > children(const std::int64_t rel) const { return tree.children(rel); }
+
+    std::int64_t subtree_n(const std::int64_t rel) const { return tree.subtree_n(rel); }
+};
+
+// targets are ranks in the communicator the mailbox belongs to
+//
+static inline void post_down(const communicator & comm, mailbox<mailbox_t> & args, const std::int64_t target, std::vector<std::string> data) {
+    args.post(
+        comm.global(target),
+        [](mailbox<mailbox_t> & args_, std::vector<std::string> data_) {
+            std::get<1>(*args_) = data_;
+            atomic_xchange( &std::get<0>(*args_), 0, 1 );
+        }, std::move(data)
+    );
+}
+
+static inline void post_local(const communicator & comm, mailbox<mailbox_t> & args, const std::int64_t target, const std::int64_t slot, std::string data) {
+    args.post(
+        comm.global(target),
+        [](mailbox<mailbox_t> & args_, std::int64_t slot_, std::string data_) {
+            std::get<3>(*args_)[slot_] = data_;
+            __atomic_add_fetch( &std::get<2>(*args_), 1, __ATOMIC_ACQ_REL );
+        }, slot, std::move(data)
+    );
+}
+
+static inline void post_tree(const communicator & comm, mailbox<mailbox_t> & args, const std::int64_t target, const std::int64_t round, std::vector<std::string> data) {
+    args.post(
+        comm.global(target),
+        [](mailbox<mailbox_t> & args_, std::int64_t round_, std::vector<std::string> data_) {
+            std::get<5>(*args_)[round_] = data_;
+            __atomic_or_fetch( &std::get<4>(*args_), std::int64_t{1} << round_, __ATOMIC_ACQ_REL );
+        }, round, std::move(data)
+    );
+}
+
+static inline std::vector<std::string> wait_down(mailbox<mailbox_t> & args) {
+    while(!atomic_xchange( &std::get<0>(*args), 1, 0 )) { transport::yield(); }
+    return std::move(std::get<1>(*args));
+}
+
+static inline void wait_local(mailbox<mailbox_t> & args, const std::int32_t count) {
+    while(__atomic_load_n( &std::get<2>(*args), __ATOMIC_ACQUIRE ) < count) { transport::yield(); }
+    __atomic_sub_fetch( &std::get<2>(*args), count, __ATOMIC_ACQ_REL );
+}
+
+static inline std::vector<std::string> wait_tree(mailbox<mailbox_t> & args, const std::int64_t round) {
+    const std::int64_t bit = std::int64_t{1} << round;
+    while((__atomic_load_n( &std::get<4>(*args), __ATOMIC_ACQUIRE ) & bit) == 0) { transport::yield(); }
+    std::vector<std::string> data = std::move(std::get<5>(*args)[round]);
+    __atomic_and_fetch( &std::get<4>(*args), ~bit, __ATOMIC_ACQ_REL );
+    return data;
+}
+
+} /* end namespace hierarchical */ } /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,187 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_MAILBOX_HPP__
+#define __HPX_COLLECTIVES_MAILBOX_HPP__
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+
+#include "transport.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// per locality table of the mailboxes sharing one registration; a
+// message for a tag nobody has attached yet is held until the tag is
+// attached, the same way AGAS would hold it for an unregistered object
+//
+class multiplexer {
+
+    std::mutex mtx;
+    std::map< std::int64_t, std::shared_ptr<void> > slots;
+    std::map< std::int64_t, std::vector< std::function<void(void *)> > > parked;
+
+public:
+    void attach(const std::int64_t tag, std::shared_ptr<void> slot) {
+        std::vector< std::function<void(void *)> > pending{};
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if(!slots.emplace(tag, slot).second) {
+                throw std::logic_error("hpx_collectives multiplexer: tag already attached");
+            }
+
+            auto itr = parked.find(tag);
+            if(itr != parked.end()) {
+                pending = std::move(itr->second);
+                parked.erase(itr);
+            }
+        }
+
+        for(auto & fn : pending) { fn(slot.get()); }
+    }
+
+    void detach(const std::int64_t tag) {
+        std::lock_guard<std::mutex> lock(mtx);
+        slots.erase(tag);
+    }
+
+    void deliver(const std::int64_t tag, std::function<void(void *)> fn) {
+        std::shared_ptr<void> slot{};
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            auto itr = slots.find(tag);
+            if(itr == slots.end()) {
+                parked[tag].push_back(std::move(fn));
+                return;
+            }
+            slot = itr->second;
+        }
+
+        fn(slot.get());
+    }
+};
+
+using multiplexer_object = transport::distributed_object< std::shared_ptr<multiplexer> >;
+
+// FNV-1a; every locality runs the same binary, but std::hash is not
+// specified to agree across builds
+//
+static inline std::int64_t mailbox_tag(const std::string & name) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for(const char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return static_cast<std::int64_t>(hash);
+}
+
+// a collective's mailbox; either registered on its own, or a tagged
+// slot in a communicator's multiplexer; actions posted to it run at the
+// mailbox's priority and receive a mailbox referring to the target
+// locality's instance, which can post on in turn
+//
+template<typename T>
+class mailbox {
+
+    T * value;
+    std::shared_ptr< transport::distributed_object<T> > object;
+    std::shared_ptr<multiplexer_object> mux;
+    std::shared_ptr<T> slot;
+    std::int64_t tag;
+    transport::handler_priority priority;
+
+    // a view for the duration of an action; the registrations are not
+    // owned, the aliasing shared_ptrs only point at them
+    //
+    mailbox(T * value_, transport::distributed_object<T> * object_, multiplexer_object * mux_, const std::int64_t tag_, const transport::handler_priority priority_) :
+        value(value_),
+        object(std::shared_ptr< transport::distributed_object<T> >{}, object_),
+        mux(std::shared_ptr<multiplexer_object>{}, mux_),
+        slot(),
+        tag(tag_),
+        priority(priority_) {
+    }
+
+public:
+    using value_type = T;
+
+    mailbox(const std::string & name, T init, const std::vector<std::int64_t> & members, const transport::handler_priority priority_=transport::handler_priority::normal) :
+        value(nullptr),
+        object(std::make_shared< transport::distributed_object<T> >(name, std::move(init), members)),
+        mux(),
+        slot(),
+        tag(0),
+        priority(priority_) {
+        value = &(**object);
+    }
+
+    mailbox(const std::shared_ptr<multiplexer_object> & mux_, const std::int64_t tag_, T init, const transport::handler_priority priority_=transport::handler_priority::normal) :
+        value(nullptr),
+        object(),
+        mux(mux_),
+        slot(std::make_shared<T>(std::move(init))),
+        tag(tag_),
+        priority(priority_) {
+        value = slot.get();
+        (**mux)->attach(tag, slot);
+    }
+
+    mailbox(const mailbox &) = delete;
+    mailbox & operator=(const mailbox &) = delete;
+
+    mailbox(mailbox && other) = default;
+
+    ~mailbox() {
+        if(slot) { (**mux)->detach(tag); }
+    }
+
+    T & operator*() { return *value; }
+    const T & operator*() const { return *value; }
+    T * operator->() { return value; }
+    const T * operator->() const { return value; }
+
+    transport::handler_priority handler_priority() const { return priority; }
+
+    // runs f(mailbox &, args...) on target against its instance
+    //
+    template<typename F, typename... Args>
+    void post(const std::int64_t target, F && f, Args &&... args) {
+        if(mux) {
+            transport::async(
+                priority, target,
+                [](multiplexer_object & mux_, std::int64_t tag_, transport::handler_priority priority_, std::decay_t<F> fn, std::decay_t<Args>... args_) {
+                    (*mux_)->deliver(tag_, [mux_, tag_, priority_, fn, args_...](void * slot_) mutable {
+                        mailbox view{static_cast<T *>(slot_), nullptr, &mux_, tag_, priority_};
+                        fn(view, args_...);
+                    });
+                }, *mux, tag, priority, std::forward<F>(f), std::forward<Args>(args)...
+            );
+        }
+        else {
+            transport::async(
+                priority, target,
+                [](transport::distributed_object<T> & object_, transport::handler_priority priority_, std::decay_t<F> fn, std::decay_t<Args>... args_) {
+                    mailbox view{&(*object_), &object_, nullptr, 0, priority_};
+                    fn(view, args_...);
+                }, *object, priority, std::forward<F>(f), std::forward<Args>(args)...
+            );
+        }
+    }
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+REGISTER_DISTRIBUTED_OBJECT_PART(std::shared_ptr<hpx::utils::collectives::multiplexer>);
+
+#endif
@@ -0,0 +1,242 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_MESH_HPP__
+#define __HPX_COLLECTIVES_MESH_HPP__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <numeric>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+
+#include "communicator.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// a Cartesian mesh of ranks: dims[d] ranks along dimension d, placed in
+// row-major order (the last dimension varies fastest); a periodic
+// dimension wraps around
+//
+// neighbours are numbered 2 d for the one below along dimension d and
+// 2 d + 1 for the one above; a rank on the edge of a non-periodic
+// dimension has no neighbour there (-1)
+//
+class cartesian_mesh {
+
+    std::vector<std::int64_t> dims_;
+    std::vector<bool> periods_;
+
+public:
+    cartesian_mesh(std::vector<std::int64_t> dims, std::vector<bool> periods) :
+        dims_(std::move(dims)), periods_(std::move(periods)) {
+        if(dims_.empty() || dims_.size() != periods_.size()) {
+            throw std::invalid_argument("hpx_collectives cartesian_mesh: one period per dimension expected");
+        }
+        for(const auto dim : dims_) {
+            if(dim < 1) { throw std::invalid_argument("hpx_collectives cartesian_mesh: empty dimension"); }
+        }
+    }
+
+    std::int64_t ndims() const { return static_cast<std::int64_t>(dims_.size()); }
+
+    const std::vector<std::int64_t> & dims() const { return dims_; }
+
+    const std::vector<bool> & periods() const { return periods_; }
+
+    std::int64_t size() const {
+        return std::accumulate(dims_.begin(), dims_.end(), std::int64_t{1}, std::multiplies<std::int64_t>{});
+    }
+
+    std::int64_t neighbor_n() const { return 2 * ndims(); }
+
+    std::vector<std::int64_t> coords(std::int64_t rank) const {
+        std::vector<std::int64_t> coords_(dims_.size(), 0);
+        for(std::int64_t d = ndims() - 1; d >= 0; --d) {
+            coords_[d] = rank % dims_[d];
+            rank /= dims_[d];
+        }
+        return coords_;
+    }
+
+    std::int64_t rank_of(const std::vector<std::int64_t> & coords_) const {
+        std::int64_t rank = 0;
+        for(std::int64_t d = 0; d < ndims(); ++d) {
+            rank = (rank * dims_[d]) + coords_[d];
+        }
+        return rank;
+    }
+
+    // neighbour i of rank, or -1
+    //
+    std::int64_t neighbor(const std::int64_t rank, const std::int64_t i) const {
+        const std::int64_t d = i / 2;
+        std::vector<std::int64_t> coords_ = coords(rank);
+        coords_[d] += (i % 2 == 0) ? -1 : 1;
+
+        if(coords_[d] < 0 || coords_[d] >= dims_[d]) {
+            if(!periods_[d]) { return -1; }
+            coords_[d] = (coords_[d] + dims_[d]) % dims_[d];
+        }
+
+        return rank_of(coords_);
+    }
+
+    // the neighbour index under which neighbour i of a rank sees that rank
+    //
+    static std::int64_t opposite(const std::int64_t i) { return i ^ 1; }
+};
+
+// a strided block of a row-major array of elements: counts[d] elements
+// along dimension d, strides[d] elements apart, from offset. faces of a
+// box are strided blocks, so they are copied straight between the array
+// and a message, with no intermediate gather buffer
+//
+class strided_block {
+
+    std::int64_t offset;
+    std::vector<std::int64_t> counts;
+    std::vector<std::int64_t> strides;
+
+    // visits the contiguous runs of the block, innermost dimension last
+    //
+    template<typename Visit>
+    void runs(Visit && visit) const {
+        const std::int64_t ndims = static_cast<std::int64_t>(counts.size());
+        if(size() == 0) { return; }
+
+        const std::int64_t run = counts[ndims - 1];
+        std::vector<std::int64_t> index(ndims, 0);
+        std::int64_t packed = 0;
+
+        while(true) {
+            std::int64_t start = offset;
+            for(std::int64_t d = 0; d < ndims - 1; ++d) { start += index[d] * strides[d]; }
+            visit(start, packed, run);
+            packed += run;
+
+            std::int64_t d = ndims - 2;
+            for(; d >= 0; --d) {
+                if(++index[d] < counts[d]) { break; }
+                index[d] = 0;
+            }
+            if(d < 0) { break; }
+        }
+    }
+
+public:
+    strided_block(const std::int64_t offset_, std::vector<std::int64_t> counts_, std::vector<std::int64_t> strides_) :
+        offset(offset_), counts(std::move(counts_)), strides(std::move(strides_)) {
+    }
+
+    std::int64_t size() const {
+        return std::accumulate(counts.begin(), counts.end(), std::int64_t{1}, std::multiplies<std::int64_t>{});
+    }
+
+    // the block's elements, in row-major order, as raw bytes; the
+    // innermost dimension must have stride 1
+    //
+    template<typename T>
+    std::string pack(const T * base) const {
+        std::string data(size() * sizeof(T), '\0');
+        runs([&](const std::int64_t start, const std::int64_t packed, const std::int64_t run) {
+            std::memcpy(&data[packed * sizeof(T)], base + start, run * sizeof(T));
+        });
+        return data;
+    }
+
+    template<typename T>
+    void unpack(const std::string & data, T * base) const {
+        if(static_cast<std::int64_t>(data.size()) != size() * static_cast<std::int64_t>(sizeof(T))) {
+            throw std::length_error("hpx_collectives strided_block: message does not match the block");
+        }
+        runs([&](const std::int64_t start, const std::int64_t packed, const std::int64_t run) {
+            std::memcpy(base + start, data.data() + (packed * sizeof(T)), run * sizeof(T));
+        });
+    }
+
+    // the layer of width halo next to side i (see cartesian_mesh) of a
+    // row-major box with extents, which include halo ghost cells on every
+    // side; ghost selects the ghost layer, otherwise the interior layer
+    // next to it. faces cover the interior of the other dimensions, no
+    // corners
+    //
+    static strided_block face(const std::vector<std::int64_t> & extents, const std::int64_t halo, const std::int64_t i, const bool ghost) {
+        const std::int64_t ndims = static_cast<std::int64_t>(extents.size());
+        const std::int64_t dim = i / 2;
+        const bool above = (i % 2) == 1;
+
+        std::vector<std::int64_t> strides(ndims, 1);
+        for(std::int64_t d = ndims - 2; d >= 0; --d) { strides[d] = strides[d + 1] * extents[d + 1]; }
+
+        std::vector<std::int64_t> counts(ndims), first(ndims, halo);
+        for(std::int64_t d = 0; d < ndims; ++d) { counts[d] = extents[d] - (2 * halo); }
+
+        counts[dim] = halo;
+        first[dim] = above ?
+            (ghost ? (extents[dim] - halo) : (extents[dim] - (2 * halo))) :
+            (ghost ? 0 : halo);
+
+        std::int64_t offset = 0;
+        for(std::int64_t d = 0; d < ndims; ++d) { offset += first[d] * strides[d]; }
+
+        return strided_block{offset, std::move(counts), std::move(strides)};
+    }
+};
+
+// the communicator laid out on a near square grid for the row and column
+// algorithms of topology_mesh: ranks, numbered relative to a root, fill
+// ceil(sqrt p) columns row by row, so row 0 is full, holds the root at
+// column 0, and only the last row can be short
+//
+// every rank is in one row group and one column group; ranks in a group
+// are ordered by column or by row, so row 0 is rank 0 of every column
+// group and column 0 is rank 0 of every row group
+//
+class mesh_grid {
+
+    std::int64_t rank_n;
+    std::int64_t root;
+    std::int64_t cols;
+
+    std::int64_t rank_of(const std::int64_t rel) const { return (rel + root) % rank_n; }
+
+public:
+    mesh_grid(const std::int64_t rank_n_, const std::int64_t root_) :
+        rank_n(rank_n_), root(root_), cols(1) {
+        while((cols * cols) < rank_n) { ++cols; }
+    }
+
+    std::int64_t row(const std::int64_t rank) const { return ((rank - root + rank_n) % rank_n) / cols; }
+
+    std::int64_t column(const std::int64_t rank) const { return ((rank - root + rank_n) % rank_n) % cols; }
+
+    communicator row_group(const communicator & comm, const std::string & agas_name) const {
+        const std::int64_t row_ = row(comm.rank_me());
+        std::vector<std::int64_t> ranks{};
+        for(std::int64_t rel = row_ * cols; rel < std::min((row_ + 1) * cols, rank_n); ++rel) {
+            ranks.push_back(rank_of(rel));
+        }
+        return comm.subgroup(agas_name + "_row" + std::to_string(row_), ranks);
+    }
+
+    communicator column_group(const communicator & comm, const std::string & agas_name) const {
+        const std::int64_t column_ = column(comm.rank_me());
+        std::vector<std::int64_t> ranks{};
+        for(std::int64_t rel = column_; rel < rank_n; rel += cols) {
+            ranks.push_back(rank_of(rel));
+        }
+        return comm.subgroup(agas_name + "_column" + std::to_string(column_), ranks);
+    }
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
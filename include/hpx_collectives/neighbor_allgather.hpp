@@ -0,0 +1,34 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_NEIGHBOR_ALLGATHER_HPP__
+#define __HPX_NEIGHBOR_ALLGATHER_HPP__
+
+#include <cstdint>
+
+#include "collective_traits.hpp" 
+
+namespace hpx { namespace utils { namespace collectives {
+
+// every rank sends one block to each of its neighbours in a topology and
+// receives one block from each; blocks from neighbours that do not exist
+// leave their place in the output untouched
+//
+template< typename CommunicationPattern, typename BlockingPolicy, typename Serialization >
+class neighbor_allgather {
+public:
+    using communication_pattern = CommunicationPattern;
+    using blocking_policy = BlockingPolicy;
+
+    neighbor_allgather();
+
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg);
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
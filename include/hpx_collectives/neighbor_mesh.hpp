@@ -0,0 +1,194 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_NEIGHBOR_MESH_HPP__
+#define __HPX_NEIGHBOR_MESH_HPP__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include "collective_traits.hpp"
+#include "neighbor_allgather.hpp"
+#include "neighbor_alltoall.hpp"
+#include "mesh.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "slots.hpp"
+
+namespace hpx { namespace utils { namespace collectives { namespace neighbor {
+
+using mailbox_t = slots::mailbox_t<std::string>;
+
+// slot i receives from neighbour i; the mailbox is attached once, when the
+// collective is built, and reused by every call
+//
+static inline mailbox<mailbox_t> attach(const communicator & comm, const cartesian_mesh & mesh, const std::string & agas_name) {
+    if(mesh.size() != comm.rank_n()) {
+        throw std::invalid_argument("hpx_collectives neighbor collective: the mesh must hold every rank of the communicator");
+    }
+    return comm.attach(agas_name, slots::make_mailbox<std::string>(mesh.neighbor_n()));
+}
+
+// posts outgoing[i] to neighbour i, all before waiting on any, then calls
+// receive(i, data) for every neighbour that exists, in neighbour order
+//
+template<typename Receive>
+void exchange(mailbox<mailbox_t> & args, const communicator & comm, const cartesian_mesh & mesh, std::vector<std::string> && outgoing, Receive && receive) {
+    const std::int64_t rank_me = comm.rank_me();
+
+    for(std::int64_t i = 0; i < mesh.neighbor_n(); ++i) {
+        const std::int64_t rank = mesh.neighbor(rank_me, i);
+        if(rank >= 0) {
+            slots::post(args, comm.global(rank), cartesian_mesh::opposite(i), std::move(outgoing[i]));
+        }
+    }
+
+    for(std::int64_t i = 0; i < mesh.neighbor_n(); ++i) {
+        if(mesh.neighbor(rank_me, i) >= 0) {
+            receive(i, slots::wait(args, i));
+        }
+    }
+}
+
+} /* end namespace neighbor */
+
+// communicator rank r sits at cartesian_mesh coordinates coords(r)
+//
+template< typename BlockingPolicy, typename Serialization >
+class neighbor_allgather< topology_mesh, BlockingPolicy, Serialization > {
+
+private:
+    communicator comm;
+    cartesian_mesh mesh;
+    mailbox<neighbor::mailbox_t> args;
+
+public:
+    using communication_pattern = hpx::utils::collectives::topology_mesh;
+    using blocking_policy = BlockingPolicy;
+
+    neighbor_allgather(const std::string agas_name, const cartesian_mesh & mesh_) :
+        neighbor_allgather(agas_name, communicator{}, mesh_) {
+    }
+
+    neighbor_allgather(const std::string agas_name, const communicator & comm_, const cartesian_mesh & mesh_) :
+        comm(comm_),
+        mesh(mesh_),
+        args{neighbor::attach(comm, mesh, agas_name)} {
+    }
+
+    // every neighbour i gets [input_beg, input_end); what neighbour i sent
+    // goes to out_beg + i * (input_end - input_beg)
+    //
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg) {
+        // https://en.cppreference.com/w/cpp/header/iterator
+        //
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        const std::int64_t count = static_cast<std::int64_t>(std::distance(input_beg, input_end));
+        const std::string block = serialization::pack_values<Serialization>(input_beg, count);
+
+        std::vector<std::string> outgoing(mesh.neighbor_n(), block);
+        neighbor::exchange(args, comm, mesh, std::move(outgoing), [&](const std::int64_t i, const std::string & data) {
+            std::int64_t received = 0;
+            serialization::unpack_values<Serialization, value_type>(data, out_beg + (i * count), received);
+        });
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+template< typename BlockingPolicy, typename Serialization >
+class neighbor_alltoall< topology_mesh, BlockingPolicy, Serialization > {
+
+private:
+    communicator comm;
+    cartesian_mesh mesh;
+    mailbox<neighbor::mailbox_t> args;
+
+public:
+    using communication_pattern = hpx::utils::collectives::topology_mesh;
+    using blocking_policy = BlockingPolicy;
+
+    neighbor_alltoall(const std::string agas_name, const cartesian_mesh & mesh_) :
+        neighbor_alltoall(agas_name, communicator{}, mesh_) {
+    }
+
+    neighbor_alltoall(const std::string agas_name, const communicator & comm_, const cartesian_mesh & mesh_) :
+        comm(comm_),
+        mesh(mesh_),
+        args{neighbor::attach(comm, mesh, agas_name)} {
+    }
+
+    // [input_beg, input_end) holds one equal block per neighbour, in
+    // neighbour order; what neighbour i sent goes to block i of out_beg
+    //
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg) {
+        // https://en.cppreference.com/w/cpp/header/iterator
+        //
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        const std::int64_t count = static_cast<std::int64_t>(std::distance(input_beg, input_end)) / mesh.neighbor_n();
+
+        std::vector<std::string> outgoing(mesh.neighbor_n());
+        for(std::int64_t i = 0; i < mesh.neighbor_n(); ++i) {
+            outgoing[i] = serialization::pack_values<Serialization>(input_beg + (i * count), count);
+        }
+
+        neighbor::exchange(args, comm, mesh, std::move(outgoing), [&](const std::int64_t i, const std::string & data) {
+            std::int64_t received = 0;
+            serialization::unpack_values<Serialization, value_type>(data, out_beg + (i * count), received);
+        });
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+    // halo exchange in place: data is this rank's row-major box with
+    // extents, halo ghost cells deep on every side. the interior layer
+    // next to side i goes to neighbour i, whose matching layer fills the
+    // ghost cells on side i; faces are copied straight between data and
+    // the messages
+    //
+    template<typename T>
+    void operator()(T * data, const std::vector<std::int64_t> & extents, const std::int64_t halo) {
+        static_assert(std::is_trivially_copyable<T>::value, "halo exchange copies elements as raw bytes");
+
+        if(static_cast<std::int64_t>(extents.size()) != mesh.ndims()) {
+            throw std::invalid_argument("hpx_collectives neighbor_alltoall: one extent per mesh dimension expected");
+        }
+
+        std::vector<std::string> outgoing(mesh.neighbor_n());
+        for(std::int64_t i = 0; i < mesh.neighbor_n(); ++i) {
+            if(mesh.neighbor(comm.rank_me(), i) >= 0) {
+                outgoing[i] = strided_block::face(extents, halo, i, false).pack(data);
+            }
+        }
+
+        neighbor::exchange(args, comm, mesh, std::move(outgoing), [&](const std::int64_t i, const std::string & message) {
+            strided_block::face(extents, halo, i, true).unpack(message, data);
+        });
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
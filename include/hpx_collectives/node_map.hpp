@@ -0,0 +1,96 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_NODE_MAP_HPP__
+#define __HPX_COLLECTIVES_NODE_MAP_HPP__
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+#include "transport.hpp"
+#include "communicator.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// which localities share a host; built once from every locality's
+// hostname, nodes are numbered in order of their lowest rank and the
+// ranks of a node are kept ascending
+//
+class node_map {
+
+private:
+    std::vector<std::int64_t> node_of_rank;
+    std::vector<std::int64_t> local_index_of_rank;
+    std::vector< std::vector<std::int64_t> > node_members;
+
+    void build(const std::vector<std::string> & hostnames) {
+        std::map<std::string, std::int64_t> node_ids{};
+
+        node_of_rank.resize(hostnames.size());
+        local_index_of_rank.resize(hostnames.size());
+
+        for(std::size_t rank = 0; rank < hostnames.size(); ++rank) {
+            auto itr = node_ids.find(hostnames[rank]);
+            if(itr == node_ids.end()) {
+                itr = node_ids.emplace(hostnames[rank], static_cast<std::int64_t>(node_members.size())).first;
+                node_members.emplace_back();
+            }
+
+            node_of_rank[rank] = itr->second;
+            local_index_of_rank[rank] = static_cast<std::int64_t>(node_members[itr->second].size());
+            node_members[itr->second].push_back(static_cast<std::int64_t>(rank));
+        }
+    }
+
+public:
+    // collective; every locality sends its hostname to locality 0, which
+    // hands the complete table back down a binomial tree
+    //
+    node_map(const std::string agas_name) :
+        node_map(agas_name, communicator{}) {
+    }
+
+    // collective over comm; ranks are the members' ranks in comm
+    //
+    node_map(const std::string agas_name, const communicator & comm) {
+        build(comm.exchange(agas_name, transport::hostname()));
+    }
+
+    // local; builds the map from a hostname per rank
+    //
+    node_map(const std::vector<std::string> & hostnames) {
+        build(hostnames);
+    }
+
+    std::int64_t size() const { return static_cast<std::int64_t>(node_of_rank.size()); }
+
+    std::int64_t node_n() const { return static_cast<std::int64_t>(node_members.size()); }
+
+    std::int64_t node_of(const std::int64_t rank) const { return node_of_rank[rank]; }
+
+    // node id of every rank, the table transport::enable_shared_memory takes
+    //
+    const std::vector<std::int64_t> & node_ids() const { return node_of_rank; }
+
+    std::int64_t local_index(const std::int64_t rank) const { return local_index_of_rank[rank]; }
+
+    const std::vector<std::int64_t> & members(const std::int64_t node) const { return node_members[node]; }
+
+    bool same_node(const std::int64_t a, const std::int64_t b) const { return node_of_rank[a] == node_of_rank[b]; }
+
+    // the root leads its own node so data never takes an extra hop
+    // on or off the root; every other node is led by its lowest rank
+    //
+    std::int64_t leader(const std::int64_t node, const std::int64_t root) const {
+        return (node_of_rank[root] == node) ? root : node_members[node].front();
+    }
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
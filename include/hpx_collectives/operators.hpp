@@ -0,0 +1,126 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_OPERATORS_HPP__
+#define __HPX_COLLECTIVES_OPERATORS_HPP__
+
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include "collective_traits.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// reduction ops and transforms the std library does not provide
+//
+struct identity {
+    template<typename T>
+    T && operator()(T && value) const { return std::forward<T>(value); }
+};
+
+template<typename T = void>
+struct minimum {
+    T operator()(const T & lhs, const T & rhs) const { return (rhs < lhs) ? rhs : lhs; }
+};
+
+template<>
+struct minimum<void> {
+    template<typename T, typename U>
+    std::common_type_t<std::decay_t<T>, std::decay_t<U>> operator()(T && lhs, U && rhs) const {
+        if(rhs < lhs) { return std::forward<U>(rhs); }
+        return std::forward<T>(lhs);
+    }
+};
+
+template<typename T = void>
+struct maximum {
+    T operator()(const T & lhs, const T & rhs) const { return (lhs < rhs) ? rhs : lhs; }
+};
+
+template<>
+struct maximum<void> {
+    template<typename T, typename U>
+    std::common_type_t<std::decay_t<T>, std::decay_t<U>> operator()(T && lhs, U && rhs) const {
+        if(lhs < rhs) { return std::forward<U>(rhs); }
+        return std::forward<T>(lhs);
+    }
+};
+
+template<typename T>
+struct is_commutative< minimum<T> > : public std::true_type {
+};
+
+template<typename T>
+struct is_commutative< maximum<T> > : public std::true_type {
+};
+
+// folds vectors of equal length element by element
+//
+template<typename BinaryOp>
+struct elementwise {
+    BinaryOp op;
+
+    template<typename Value>
+    std::vector<Value> operator()(std::vector<Value> lhs, const std::vector<Value> & rhs) {
+        const std::size_t n = std::min(lhs.size(), rhs.size());
+        for(std::size_t i = 0; i < n; ++i) {
+            lhs[i] = op(lhs[i], rhs[i]);
+        }
+        return lhs;
+    }
+};
+
+template<typename BinaryOp>
+struct is_commutative< elementwise<BinaryOp> > : public is_commutative<BinaryOp> {
+};
+
+// several reductions carried through one traversal: a tuple of partial
+// results, combined element-wise by a tuple of ops, one per element
+//
+template<typename... BinaryOps>
+struct fused {
+    std::tuple<BinaryOps...> ops;
+
+    template<typename... Ts>
+    std::tuple<Ts...> operator()(const std::tuple<Ts...> & lhs, const std::tuple<Ts...> & rhs) const {
+        static_assert(sizeof...(Ts) == sizeof...(BinaryOps), "fused: one op per tuple element");
+        return combine(lhs, rhs, std::index_sequence_for<Ts...>{});
+    }
+
+    // folds one input element into every partial result, through the
+    // transform of each
+    //
+    template<typename... Ts, typename... Transforms, typename ValueType>
+    void fold(std::tuple<Ts...> & partial, const std::tuple<Transforms...> & transforms, const ValueType & value) const {
+        fold(partial, transforms, value, std::index_sequence_for<Ts...>{});
+    }
+
+private:
+    template<typename Tuple, std::size_t... I>
+    Tuple combine(const Tuple & lhs, const Tuple & rhs, std::index_sequence<I...>) const {
+        return Tuple{ std::get<I>(ops)(std::get<I>(lhs), std::get<I>(rhs))... };
+    }
+
+    template<typename Tuple, typename TransformTuple, typename ValueType, std::size_t... I>
+    void fold(Tuple & partial, const TransformTuple & transforms, const ValueType & value, std::index_sequence<I...>) const {
+        ((std::get<I>(partial) = std::get<I>(ops)(std::get<I>(partial), std::get<I>(transforms)(value))), ...);
+    }
+};
+
+template<typename... BinaryOps>
+fused(std::tuple<BinaryOps...>) -> fused<BinaryOps...>;
+
+template<typename... BinaryOps>
+struct is_commutative< fused<BinaryOps...> > : public std::conjunction< is_commutative<BinaryOps>... > {
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
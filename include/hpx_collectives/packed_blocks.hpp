@@ -0,0 +1,112 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_PACKED_BLOCKS_HPP__
+#define __HPX_COLLECTIVES_PACKED_BLOCKS_HPP__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "mailbox.hpp"
+#include "slots.hpp"
+#include "utils.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// consecutive serialized blocks in one contiguous buffer; block i is
+// data[offsets[i], offsets[i + 1]). the root packs every block once and
+// the tree forwards byte ranges of the buffer; nothing is deserialized
+// until a block reaches its owner
+//
+class packed_blocks {
+
+    std::string data;
+    std::vector<std::int64_t> offsets;
+
+public:
+    packed_blocks() :
+        data(), offsets(1, 0) {
+    }
+
+    packed_blocks(std::string data_, std::vector<std::int64_t> offsets_) :
+        data(std::move(data_)), offsets(std::move(offsets_)) {
+    }
+
+    std::int64_t size() const { return static_cast<std::int64_t>(offsets.size()) - 1; }
+
+    std::int64_t bytes() const { return static_cast<std::int64_t>(data.size()); }
+
+    void reserve(const std::int64_t block_n, const std::int64_t bytes_) {
+        offsets.reserve(block_n + 1);
+        data.reserve(bytes_);
+    }
+
+    // appends [input_beg, input_end) as the next block, in the
+    // serialization::pack_range format
+    //
+    template<typename Serialization, typename InputIterator>
+    void append(InputIterator input_beg, InputIterator input_end) {
+        data.append(serialization::pack_range<Serialization>(input_beg, input_end));
+        offsets.push_back(static_cast<std::int64_t>(data.size()));
+    }
+
+    // appends the blocks of other after the blocks of this buffer; the
+    // bytes are copied once, nothing is deserialized
+    //
+    void append(const packed_blocks & other) {
+        const std::int64_t base = bytes();
+        data.append(other.data);
+        for(auto itr = other.offsets.begin() + 1; itr != other.offsets.end(); ++itr) {
+            offsets.push_back(base + (*itr));
+        }
+    }
+
+    // blocks [first, last) as a buffer of their own; one copy of the
+    // bytes, no serialization
+    //
+    packed_blocks slice(const std::int64_t first, const std::int64_t last) const {
+        std::vector<std::int64_t> sliced(offsets.begin() + first, offsets.begin() + last + 1);
+        for(auto & offset : sliced) { offset -= offsets[first]; }
+        return packed_blocks{data.substr(offsets[first], offsets[last] - offsets[first]), std::move(sliced)};
+    }
+
+    // writes the elements of block i to out_beg and returns the iterator
+    // past the last one written
+    //
+    template<typename Serialization, typename ValueType, typename OutputIterator>
+    OutputIterator unpack(const std::int64_t i, OutputIterator out_beg) const {
+        return serialization::unpack_range<Serialization, ValueType>(data.substr(offsets[i], offsets[i + 1] - offsets[i]), out_beg);
+    }
+
+    // ships the buffer and its index as separate arguments, so transports
+    // that stage large strings (shared memory) stage the bytes
+    //
+    template<typename Mailbox>
+    void post(Mailbox & args, const std::int64_t target, const std::int64_t slot) && {
+        args.post(
+            target,
+            [](Mailbox & args_, std::int64_t slot_, std::string data_, std::vector<std::int64_t> offsets_) {
+                std::get<1>(*args_)[slot_] = packed_blocks{std::move(data_), std::move(offsets_)};
+                atomic_xchange( &std::get<0>(*args_)[slot_], 0, 1 );
+            }, slot, std::move(data), std::move(offsets)
+        );
+    }
+
+    template<typename Archive>
+    void serialize(Archive & ar, const unsigned int) {
+        ar & data & offsets;
+    }
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+REGISTER_DISTRIBUTED_OBJECT_PART(std::tuple<std::vector<std::int32_t>, std::vector<hpx::utils::collectives::packed_blocks>>);
+
+#endif
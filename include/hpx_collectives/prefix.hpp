@@ -0,0 +1,157 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_PREFIX_HPP__
+#define __HPX_COLLECTIVES_PREFIX_HPP__
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <cstdint>
+#include <utility>
+
+#include "collective_traits.hpp"
+#include "transport.hpp"
+#include "serialization.hpp"
+#include "communicator.hpp"
+#include "slots.hpp"
+
+namespace hpx { namespace utils { namespace collectives { namespace prefix {
+
+// a slot per round of the pattern, plus one for the binomial down sweep
+//
+using mailbox_t = slots::mailbox_t<std::string>;
+
+static inline mailbox_t make_mailbox(const std::int64_t rank_n) {
+    return slots::make_mailbox<std::string>(slots::rounds(rank_n) + 1);
+}
+
+template<typename Serialization, typename T>
+void post(mailbox<mailbox_t> & args, const std::int64_t target, const std::int64_t slot, const T & value) {
+    slots::post(args, target, slot, serialization::pack<Serialization>(value));
+}
+
+template<typename Serialization, typename T>
+T wait(mailbox<mailbox_t> & args, const std::int64_t slot) {
+    return serialization::unpack<Serialization, T>(slots::wait(args, slot));
+}
+
+// parallel prefix over the ranks of a communicator, in rank order;
+// op is applied as op(lower ranks, higher ranks), so it only needs to be
+// associative. every member gets the combination of the values of ranks
+// [0, rank_me] and, except rank 0, of ranks [0, rank_me)
+//
+template<typename CommunicationPattern, typename Serialization>
+class engine;
+
+// recursive doubling; ceil(log2 p) rounds, each rank sends one message
+// per round to rank + 2^round and folds the one from rank - 2^round
+//
+template<typename Serialization>
+class engine<topology_hypercube, Serialization> {
+
+    communicator comm;
+    mailbox<mailbox_t> args;
+
+public:
+    engine(const std::string & agas_name, const communicator & comm_) :
+        comm(comm_),
+        args{comm.attach(agas_name, make_mailbox(comm.rank_n()))} {
+    }
+
+    const communicator & get_communicator() const { return comm; }
+
+    template<typename T, typename BinaryOp>
+    bool operator()(const T & value, BinaryOp op, T & inclusive, T & exclusive) {
+        const std::int64_t rank_n = comm.rank_n();
+        const std::int64_t rank_me = comm.rank_me();
+
+        bool has_exclusive = false;
+        inclusive = value;
+
+        for(std::int64_t round = 0; (std::int64_t{1} << round) < rank_n; ++round) {
+            const std::int64_t distance = std::int64_t{1} << round;
+
+            if(rank_me + distance < rank_n) {
+                post<Serialization>(args, comm.global(rank_me + distance), round, inclusive);
+            }
+
+            if(rank_me >= distance) {
+                T lower = wait<Serialization, T>(args, round);
+                exclusive = has_exclusive ? op(lower, exclusive) : lower;
+                inclusive = op(std::move(lower), inclusive);
+                has_exclusive = true;
+            }
+        }
+
+        return has_exclusive;
+    }
+};
+
+// up and down sweep over the binomial tree rooted at rank 0; a subtree
+// covers a contiguous range of ranks, so 2(p - 1) messages in 2 log2 p
+// rounds instead of p log2 p
+//
+template<typename Serialization>
+class engine<tree_binomial, Serialization> {
+
+    communicator comm;
+    mailbox<mailbox_t> args;
+
+public:
+    engine(const std::string & agas_name, const communicator & comm_) :
+        comm(comm_),
+        args{comm.attach(agas_name, make_mailbox(comm.rank_n()))} {
+    }
+
+    const communicator & get_communicator() const { return comm; }
+
+    template<typename T, typename BinaryOp>
+    bool operator()(const T & value, BinaryOp op, T & inclusive, T & exclusive) {
+        const std::int64_t rank_me = comm.rank_me();
+        const std::int64_t down_slot = slots::rounds(comm.rank_n());
+        const binomial_schedule tree = comm.schedule();
+        const auto children = tree.children(rank_me);
+
+        // up sweep; before[i] is what precedes child i within this subtree
+        //
+        std::vector<T> before{};
+        before.reserve(children.size());
+
+        T subtree{value};
+        for(const auto & child : children) {
+            before.push_back(subtree);
+            subtree = op(subtree, wait<Serialization, T>(args, child.second));
+        }
+
+        bool has_exclusive = false;
+        if(rank_me != 0) {
+            std::int64_t round = 0;
+            const std::int64_t parent = tree.parent(rank_me, round);
+            post<Serialization>(args, comm.global(parent), round, subtree);
+
+            exclusive = wait<Serialization, T>(args, down_slot);
+            has_exclusive = true;
+        }
+
+        inclusive = has_exclusive ? op(exclusive, value) : value;
+
+        // down sweep, farthest child first since it heads the largest subtree
+        //
+        for(std::size_t i = children.size(); i-- > 0;) {
+            post<Serialization>(
+                args, comm.global(children[i].first), down_slot,
+                has_exclusive ? op(exclusive, before[i]) : before[i]
+            );
+        }
+
+        return has_exclusive;
+    }
+};
+
+} /* end namespace prefix */ } /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
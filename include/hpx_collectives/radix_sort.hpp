@@ -0,0 +1,144 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_RADIX_SORT_HPP__
+#define __HPX_COLLECTIVES_RADIX_SORT_HPP__
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <functional>
+#include <type_traits>
+
+namespace hpx { namespace utils { namespace collectives { namespace radix {
+
+// least significant digit radix sort, one byte per pass, for integer and
+// floating point keys in ascending order; keys are mapped to unsigned
+// integers of the same width whose order is the keys' order, so the sort
+// is linear in the number of keys. passes in which every key has the
+// same byte are skipped. only 1, 2, 4 and 8 byte keys and IEEE 754
+// floating point qualify (long double has padding bytes); other keys
+// fall back to std::sort
+//
+template<typename Key>
+struct is_sortable : public std::integral_constant<bool,
+    (sizeof(Key) == 1 || sizeof(Key) == 2 || sizeof(Key) == 4 || sizeof(Key) == 8) &&
+    ((std::is_integral<Key>::value && !std::is_same<Key, bool>::value) ||
+     (std::is_floating_point<Key>::value && std::numeric_limits<Key>::is_iec559))> {
+};
+
+// the comparisons the radix order agrees with
+//
+template<typename Key, typename Compare>
+struct is_ascending : public std::false_type {
+};
+
+template<typename Key>
+struct is_ascending< Key, std::less<Key> > : public std::true_type {
+};
+
+template<typename Key>
+struct is_ascending< Key, std::less<> > : public std::true_type {
+};
+
+template<std::size_t Bytes> struct unsigned_of;
+template<> struct unsigned_of<1> { using type = std::uint8_t; };
+template<> struct unsigned_of<2> { using type = std::uint16_t; };
+template<> struct unsigned_of<4> { using type = std::uint32_t; };
+template<> struct unsigned_of<8> { using type = std::uint64_t; };
+
+template<typename Key>
+using unsigned_t = typename unsigned_of<sizeof(Key)>::type;
+
+// signed integers: flip the sign bit; floating point: flip every bit of
+// negatives and the sign bit of the rest
+//
+template<typename Key>
+unsigned_t<Key> to_ordered(const Key key) {
+    using U = unsigned_t<Key>;
+    constexpr U sign = U{1} << ((sizeof(Key) * 8) - 1);
+
+    U bits = 0;
+    std::memcpy(&bits, &key, sizeof(Key));
+
+    if constexpr(std::is_floating_point<Key>::value) {
+        return (bits & sign) ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+    }
+    else if constexpr(std::is_signed<Key>::value) {
+        return static_cast<U>(bits ^ sign);
+    }
+    else {
+        return bits;
+    }
+}
+
+template<typename Key>
+Key from_ordered(const unsigned_t<Key> ordered) {
+    using U = unsigned_t<Key>;
+    constexpr U sign = U{1} << ((sizeof(Key) * 8) - 1);
+
+    U bits = ordered;
+    if constexpr(std::is_floating_point<Key>::value) {
+        bits = (ordered & sign) ? static_cast<U>(ordered ^ sign) : static_cast<U>(~ordered);
+    }
+    else if constexpr(std::is_signed<Key>::value) {
+        bits = static_cast<U>(ordered ^ sign);
+    }
+
+    Key key;
+    std::memcpy(&key, &bits, sizeof(Key));
+    return key;
+}
+
+template<typename Key>
+void sort(std::vector<Key> & keys) {
+    static_assert(is_sortable<Key>::value, "radix::sort needs integer or floating point keys");
+    using U = unsigned_t<Key>;
+
+    const std::size_t n = keys.size();
+    if(n < 2) { return; }
+
+    constexpr std::size_t digits = sizeof(U);
+
+    // every pass's histogram comes from one read of the keys
+    //
+    std::vector<U> ordered(n), scratch(n);
+    std::vector< std::array<std::size_t, 256> > histograms(digits);
+    for(auto & histogram : histograms) { histogram.fill(0); }
+
+    for(std::size_t i = 0; i < n; ++i) {
+        const U value = to_ordered(keys[i]);
+        ordered[i] = value;
+        for(std::size_t digit = 0; digit < digits; ++digit) {
+            ++histograms[digit][(value >> (digit * 8)) & 0xffu];
+        }
+    }
+
+    for(std::size_t digit = 0; digit < digits; ++digit) {
+        const std::size_t shift = digit * 8;
+        auto & offsets = histograms[digit];
+
+        if(offsets[(ordered.front() >> shift) & 0xffu] == n) { continue; }
+
+        std::size_t total = 0;
+        for(auto & offset : offsets) {
+            const std::size_t count = offset;
+            offset = total;
+            total += count;
+        }
+
+        for(const U value : ordered) { scratch[offsets[(value >> shift) & 0xffu]++] = value; }
+        ordered.swap(scratch);
+    }
+
+    for(std::size_t i = 0; i < n; ++i) { keys[i] = from_ordered<Key>(ordered[i]); }
+}
+
+} /* end namespace radix */ } /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
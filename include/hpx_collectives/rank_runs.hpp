@@ -0,0 +1,133 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_RANK_RUNS_HPP__
+#define __HPX_COLLECTIVES_RANK_RUNS_HPP__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+namespace hpx { namespace utils { namespace collectives {
+
+// the partial result of a subtree under a non-commutative op, one value
+// per run: a run is a set of ranks that are consecutive in rank order,
+// so a value folds them in rank order
+//
+// a subtree is not always one run. the ranks of a tree rooted at root
+// wrap around from rank_n - 1 to 0, and a k-ary subtree is one range of
+// ranks per level. runs are numbered so that folding them in increasing
+// order is rank order: the ranks before root, then the ranks from root
+// on, each level by level (Schedule::run). merging a child's runs into
+// a parent's, children in schedule order, keeps every run in rank order
+//
+template<typename ValueType>
+class rank_runs {
+
+    std::vector< std::pair<std::int64_t, ValueType> > runs;
+
+    template<typename T>
+    static void put(std::string & data, const T value) {
+        const std::size_t at = data.size();
+        data.resize(at + sizeof(T));
+        std::memcpy(&data[at], &value, sizeof(T));
+    }
+
+    template<typename T>
+    static T get(const std::string & data, std::size_t & at) {
+        T value{};
+        std::memcpy(&value, data.data() + at, sizeof(T));
+        at += sizeof(T);
+        return value;
+    }
+
+public:
+    // run of relative rank rel in a tree laid out by schedule over comm
+    // ranks rooted at root
+    //
+    template<typename Schedule>
+    static std::int64_t run(const Schedule & schedule, const std::int64_t rel, const std::int64_t root) {
+        const bool wrapped = rel >= (schedule.size() - root);
+        return (wrapped ? 0 : schedule.size()) + schedule.run(rel);
+    }
+
+    rank_runs() :
+        runs() {
+    }
+
+    rank_runs(const std::int64_t run_, ValueType value) :
+        runs() {
+        runs.emplace_back(run_, std::move(value));
+    }
+
+    // folds the runs of a subtree whose ranks follow this one's into it;
+    // merge(mine, theirs) folds theirs into mine
+    //
+    template<typename Merge>
+    void append(rank_runs && other, Merge && merge) {
+        for(auto & part : other.runs) {
+            auto itr = std::lower_bound(runs.begin(), runs.end(), part.first, [](const std::pair<std::int64_t, ValueType> & entry, const std::int64_t run_) {
+                return entry.first < run_;
+            });
+
+            if(itr != runs.end() && itr->first == part.first) {
+                merge(itr->second, std::move(part.second));
+            }
+            else {
+                runs.insert(itr, std::move(part));
+            }
+        }
+    }
+
+    // every run folded into one value, in rank order
+    //
+    template<typename Merge>
+    ValueType fold(Merge && merge) && {
+        ValueType result = std::move(runs.front().second);
+        for(auto itr = runs.begin() + 1; itr != runs.end(); ++itr) {
+            merge(result, std::move(itr->second));
+        }
+        return result;
+    }
+
+    // the run count, then each run's number, byte length and bytes;
+    // pack converts a value to its wire form
+    //
+    template<typename Pack>
+    std::string pack(Pack && pack_) const {
+        std::string data{};
+        put(data, static_cast<std::int64_t>(runs.size()));
+        for(const auto & part : runs) {
+            const std::string bytes = pack_(part.second);
+            put(data, part.first);
+            put(data, static_cast<std::int64_t>(bytes.size()));
+            data.append(bytes);
+        }
+        return data;
+    }
+
+    template<typename Unpack>
+    static rank_runs unpack(const std::string & data, Unpack && unpack_) {
+        rank_runs result{};
+        std::size_t at = 0;
+        const std::int64_t count = get<std::int64_t>(data, at);
+        result.runs.reserve(count);
+        for(std::int64_t i = 0; i < count; ++i) {
+            const std::int64_t run_ = get<std::int64_t>(data, at);
+            const std::int64_t len = get<std::int64_t>(data, at);
+            result.runs.emplace_back(run_, unpack_(data.substr(at, len)));
+            at += len;
+        }
+        return result;
+    }
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,140 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_REDUCE_ADAPTIVE_HPP__
+#define __HPX_REDUCE_ADAPTIVE_HPP__
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <iterator>
+
+#include "collective_traits.hpp"
+#include "reduce.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "straggler.hpp"
+#include "slots.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// k-nomial reduce over a straggler_placement: every period calls the
+// ranks exchange what they observed and rebuild the placement, so a
+// locality that keeps arriving late is moved to a leaf, where nobody
+// waits on it but the root. the rebuild is one exchange over the
+// communicator; a period of 0 keeps the tree fixed
+//
+// ranks are placed out of order, so op must be commutative (see
+// is_commutative); children are folded as they arrive
+//
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class reduce< tree_adaptive<K>, BlockingPolicy, Serialization > {
+
+    using mailbox_t = slots::mailbox_t<std::string>;
+
+private:
+    std::string name;
+    communicator comm;
+    std::int64_t period;
+    straggler_placement<K> placement_;
+    mailbox<mailbox_t> args;
+
+    static double since(const std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void rebuild() {
+        const auto reports = comm.exchange(name + "_placement" + std::to_string(placement_.epoch()), placement_.report(comm.rank_me()));
+        placement_.rebuild(reports);
+    }
+
+public:
+    using communication_pattern = tree_adaptive<K>;
+    using blocking_policy = BlockingPolicy;
+
+    reduce(const std::string agas_name, const std::int64_t root_=0, const std::int64_t period_=16) :
+        reduce(agas_name, communicator{}, root_, period_) {
+    }
+
+    // root is a rank in comm_; period must agree on every rank
+    //
+    reduce(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0, const std::int64_t period_=16) :
+        name(agas_name),
+        comm(comm_),
+        period(period_),
+        placement_(comm.rank_n(), root_),
+        args{comm.attach(agas_name, slots::make_mailbox<std::string>(knomial_schedule<K>{comm.rank_n()}.slot_n()))} {
+    }
+
+    const straggler_placement<K> & placement() const { return placement_; }
+
+    template<typename InputIterator, typename BinaryOp>
+    void operator()(InputIterator input_beg, InputIterator input_end, typename std::iterator_traits<InputIterator>::value_type init, BinaryOp op, typename std::iterator_traits<InputIterator>::value_type & output) {
+        static_assert(is_commutative<BinaryOp>::value, "hpx_collectives reduce: an adaptive tree places ranks out of order, op must be commutative");
+
+        // https://en.cppreference.com/w/cpp/header/iterator
+        //
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        const auto & tree = placement_.schedule();
+        const std::int64_t position = placement_.position(comm.rank_me());
+
+        value_type local_result{std::reduce(input_beg, input_end, init, op)};
+        const auto ready = std::chrono::steady_clock::now();
+
+        const auto children = tree.children(position);
+        const std::int64_t child_n = static_cast<std::int64_t>(children.size());
+
+        std::vector<double> delays(child_n, -1.0);
+        std::int64_t remaining = child_n;
+        std::string data{};
+
+        while(remaining > 0) {
+            bool progress = false;
+
+            for(std::int64_t i = 0; i < child_n; ++i) {
+                if(delays[i] >= 0.0 || !slots::try_wait(args, children[i].second, data)) { continue; }
+
+                delays[i] = since(ready);
+                --remaining;
+                progress = true;
+
+                local_result = op(std::move(local_result), serialization::unpack<Serialization, value_type>(data));
+            }
+
+            if(!progress) { transport::yield(); }
+        }
+
+        const double waited = since(ready);
+
+        if(position != 0) {
+            std::int64_t slot = 0;
+            const std::int64_t parent = tree.parent(position, slot);
+            slots::post(args, comm.global(placement_.rank_at(parent)), slot, serialization::pack<Serialization>(local_result));
+        }
+        else {
+            output = std::move(local_result);
+        }
+
+        placement_.observe(delays, waited);
+        if(period > 0 && placement_.calls() == period) {
+            rebuild();
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+    } // end operator()
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
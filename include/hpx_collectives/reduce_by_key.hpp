@@ -0,0 +1,108 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_REDUCE_BY_KEY_HPP__
+#define __HPX_REDUCE_BY_KEY_HPP__
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
+#include "collective_traits.hpp" 
+
+namespace hpx { namespace utils { namespace collectives {
+
+// reduces (key, value) pairs held across localities: the values of equal
+// keys are folded with op, and the result comes back sorted by key. tree
+// patterns deliver every key to the root; partition_hash delivers each key
+// to the locality its hash selects
+//
+template< typename CommunicationPattern, typename BlockingPolicy, typename Serialization >
+class reduce_by_key {
+public:
+    using communication_pattern = CommunicationPattern;
+    using blocking_policy = BlockingPolicy;
+
+    reduce_by_key(const std::int64_t root_=0);
+
+    // returns the number of keys written
+    //
+    template<typename KeyIterator, typename ValueIterator, typename KeyOutputIterator, typename ValueOutputIterator, typename BinaryOp>
+    std::int64_t operator()(KeyIterator keys_beg, KeyIterator keys_end, ValueIterator values_beg, KeyOutputIterator keys_out, ValueOutputIterator values_out, BinaryOp op);
+};
+
+namespace by_key {
+
+// sorts [keys_beg, keys_end) with its values and folds the values of
+// equal keys in input order, leaving sorted unique keys
+//
+template<typename KeyIterator, typename ValueIterator, typename Key, typename Value, typename BinaryOp>
+void combine(KeyIterator keys_beg, KeyIterator keys_end, ValueIterator values_beg, BinaryOp & op, std::vector<Key> & keys, std::vector<Value> & values) {
+    std::vector< std::pair<Key, Value> > pairs{};
+    pairs.reserve(static_cast<std::size_t>(std::distance(keys_beg, keys_end)));
+    for(; keys_beg != keys_end; ++keys_beg, ++values_beg) {
+        pairs.emplace_back(*keys_beg, *values_beg);
+    }
+
+    std::stable_sort(pairs.begin(), pairs.end(),
+        [](const std::pair<Key, Value> & lhs, const std::pair<Key, Value> & rhs) { return lhs.first < rhs.first; });
+
+    keys.clear();
+    values.clear();
+    for(auto & pair : pairs) {
+        if(!keys.empty() && !(keys.back() < pair.first)) {
+            values.back() = op(values.back(), std::move(pair.second));
+        }
+        else {
+            keys.push_back(std::move(pair.first));
+            values.push_back(std::move(pair.second));
+        }
+    }
+}
+
+// merges the sorted unique run (other_keys, other_values) into
+// (keys, values); the values of a key in both runs fold as op(mine, other)
+//
+template<typename Key, typename Value, typename BinaryOp>
+void merge(std::vector<Key> & keys, std::vector<Value> & values, std::vector<Key> && other_keys, std::vector<Value> && other_values, BinaryOp & op) {
+    if(other_keys.empty()) { return; }
+
+    std::vector<Key> merged_keys{};
+    std::vector<Value> merged_values{};
+    merged_keys.reserve(keys.size() + other_keys.size());
+    merged_values.reserve(keys.size() + other_keys.size());
+
+    std::size_t i = 0, j = 0;
+    while(i < keys.size() || j < other_keys.size()) {
+        if(j == other_keys.size() || (i < keys.size() && keys[i] < other_keys[j])) {
+            merged_keys.push_back(std::move(keys[i]));
+            merged_values.push_back(std::move(values[i]));
+            ++i;
+        }
+        else if(i == keys.size() || other_keys[j] < keys[i]) {
+            merged_keys.push_back(std::move(other_keys[j]));
+            merged_values.push_back(std::move(other_values[j]));
+            ++j;
+        }
+        else {
+            merged_keys.push_back(std::move(keys[i]));
+            merged_values.push_back(op(std::move(values[i]), std::move(other_values[j])));
+            ++i;
+            ++j;
+        }
+    }
+
+    keys = std::move(merged_keys);
+    values = std::move(merged_values);
+}
+
+} /* end namespace by_key */
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
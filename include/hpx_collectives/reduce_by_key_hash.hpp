@@ -0,0 +1,122 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_REDUCE_BY_KEY_HASH_HPP__
+#define __HPX_REDUCE_BY_KEY_HASH_HPP__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <functional>
+
+#include "collective_traits.hpp"
+#include "reduce_by_key.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "slots.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// all-to-all: every rank combines its pairs, splits them by the owner
+// hash(key) % rank_n selects and sends every other rank its part in one
+// columnar message; every rank then merges what it owns. no locality
+// ever holds the whole key space, which is the point when it is large
+//
+// slot s receives from rank s, and rank r sends to r + 1, r + 2, ... so
+// no rank is the first target of every sender
+//
+template< typename BlockingPolicy, typename Serialization >
+class reduce_by_key< partition_hash, BlockingPolicy, Serialization > {
+
+    using mailbox_t = slots::mailbox_t<std::string>;
+
+private:
+    communicator comm;
+    mailbox<mailbox_t> args;
+
+public:
+    using communication_pattern = hpx::utils::collectives::partition_hash;
+    using blocking_policy = BlockingPolicy;
+
+    reduce_by_key(const std::string agas_name) :
+        reduce_by_key(agas_name, communicator{}) {
+    }
+
+    reduce_by_key(const std::string agas_name, const communicator & comm_) :
+        comm(comm_),
+        args{comm.attach(agas_name, slots::make_mailbox<std::string>(comm.rank_n()))} {
+    }
+
+    // every rank writes the keys it owns and their folded values, sorted
+    // by key, and gets their number back; hash must agree on every rank
+    //
+    template<typename KeyIterator, typename ValueIterator, typename KeyOutputIterator, typename ValueOutputIterator, typename BinaryOp, typename Hash = std::hash< typename std::iterator_traits<KeyIterator>::value_type > >
+    std::int64_t operator()(KeyIterator keys_beg, KeyIterator keys_end, ValueIterator values_beg, KeyOutputIterator keys_out, ValueOutputIterator values_out, BinaryOp op, Hash hash = Hash{}) {
+        // https://en.cppreference.com/w/cpp/header/iterator
+        //
+        using key_type = typename std::iterator_traits<KeyIterator>::value_type;
+        using value_type = typename std::iterator_traits<ValueIterator>::value_type;
+
+        const std::int64_t rank_n = comm.rank_n();
+        const std::int64_t rank_me = comm.rank_me();
+
+        std::vector<key_type> keys{};
+        std::vector<value_type> values{};
+        by_key::combine(keys_beg, keys_end, values_beg, op, keys, values);
+
+        // split the sorted run by owner; each part stays sorted
+        //
+        std::vector< std::vector<key_type> > part_keys(rank_n);
+        std::vector< std::vector<value_type> > part_values(rank_n);
+        for(std::size_t i = 0; i < keys.size(); ++i) {
+            const std::int64_t owner = static_cast<std::int64_t>(hash(keys[i]) % static_cast<std::size_t>(rank_n));
+            part_keys[owner].push_back(std::move(keys[i]));
+            part_values[owner].push_back(std::move(values[i]));
+        }
+
+        for(std::int64_t step = 1; step < rank_n; ++step) {
+            const std::int64_t target = (rank_me + step) % rank_n;
+            slots::post(args, comm.global(target), rank_me,
+                serialization::pack_columns<Serialization>(part_keys[target].begin(), part_keys[target].end(), part_values[target].begin()));
+        }
+
+        keys.clear();
+        values.clear();
+
+        // merged in rank order, so a non-commutative op folds the values
+        // of a key in rank order
+        //
+        for(std::int64_t source = 0; source < rank_n; ++source) {
+            if(source == rank_me) {
+                by_key::merge(keys, values, std::move(part_keys[source]), std::move(part_values[source]), op);
+                continue;
+            }
+
+            std::vector<key_type> other_keys{};
+            std::vector<value_type> other_values{};
+            serialization::unpack_columns<Serialization>(slots::wait(args, source), other_keys, other_values);
+            by_key::merge(keys, values, std::move(other_keys), std::move(other_values), op);
+        }
+
+        std::move(keys.begin(), keys.end(), keys_out);
+        std::move(values.begin(), values.end(), values_out);
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+        return static_cast<std::int64_t>(keys.size());
+
+    } // end operator()
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,187 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_REDUCE_BY_KEY_TREE_HPP__
+#define __HPX_REDUCE_BY_KEY_TREE_HPP__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+
+#include "collective_traits.hpp"
+#include "reduce_by_key.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "schedule.hpp"
+#include "rank_runs.hpp"
+#include "slots.hpp"
+
+namespace hpx { namespace utils { namespace collectives { namespace tree {
+
+// every rank sorts and combines its pairs into one run of unique keys,
+// merges its children's runs into it and sends the merged run to its
+// parent, keys and values in separate columns; the root ends up with
+// every key. a run never holds a key twice, so a link carries at most
+// one pair per distinct key in the subtree below it
+//
+// runs are merged as they arrive when op is commutative. otherwise the
+// values of a key must fold in rank order, so a subtree's run is kept
+// apart per run of consecutive ranks (see rank_runs), children merged in
+// child order, and the root merges those in rank order at the end
+//
+template< typename Schedule, typename BlockingPolicy, typename Serialization >
+class reduce_by_key {
+
+    using mailbox_t = slots::mailbox_t<std::string>;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    mailbox<mailbox_t> args;
+
+public:
+    using blocking_policy = BlockingPolicy;
+
+    reduce_by_key(const std::string agas_name, const std::int64_t root_=0) :
+        reduce_by_key(agas_name, communicator{}, root_) {
+    }
+
+    // root is a rank in comm_
+    //
+    reduce_by_key(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0) :
+        root(root_),
+        comm(comm_),
+        args{comm.attach(agas_name, slots::make_mailbox<std::string>(Schedule{comm.rank_n()}.slot_n()))} {
+    }
+
+    // the root writes every distinct key and its folded value, sorted by
+    // key, and gets their number back; other ranks get 0
+    //
+    template<typename KeyIterator, typename ValueIterator, typename KeyOutputIterator, typename ValueOutputIterator, typename BinaryOp>
+    std::int64_t operator()(KeyIterator keys_beg, KeyIterator keys_end, ValueIterator values_beg, KeyOutputIterator keys_out, ValueOutputIterator values_out, BinaryOp op) {
+        // https://en.cppreference.com/w/cpp/header/iterator
+        //
+        using key_type = typename std::iterator_traits<KeyIterator>::value_type;
+        using value_type = typename std::iterator_traits<ValueIterator>::value_type;
+
+        const Schedule tree{comm.rank_n()};
+        const std::int64_t rank_me = comm.relative(comm.rank_me(), root);
+
+        std::vector<key_type> keys{};
+        std::vector<value_type> values{};
+        by_key::combine(keys_beg, keys_end, values_beg, op, keys, values);
+
+        const auto children = tree.children(rank_me);
+        const std::int64_t child_n = static_cast<std::int64_t>(children.size());
+
+        using run_t = std::pair< std::vector<key_type>, std::vector<value_type> >;
+
+        const auto merge = [&op](run_t & lhs, run_t && rhs) {
+            by_key::merge(lhs.first, lhs.second, std::move(rhs.first), std::move(rhs.second), op);
+        };
+
+        const auto pack = [](const run_t & run) {
+            return serialization::pack_columns<Serialization>(run.first.begin(), run.first.end(), run.second.begin());
+        };
+
+        const auto unpack = [](const std::string & data_) {
+            run_t run{};
+            serialization::unpack_columns<Serialization>(data_, run.first, run.second);
+            return run;
+        };
+
+        rank_runs<run_t> ordered{};
+        if constexpr(!is_commutative<BinaryOp>::value) {
+            ordered = rank_runs<run_t>{rank_runs<run_t>::run(tree, rank_me, root), run_t{std::move(keys), std::move(values)}};
+        }
+
+        std::vector<bool> received(child_n, false);
+        std::vector< rank_runs<run_t> > pending(child_n);
+        std::int64_t remaining = child_n, merged = 0;
+        std::string data{};
+
+        while(remaining > 0) {
+            bool progress = false;
+
+            for(std::int64_t i = 0; i < child_n; ++i) {
+                if(received[i] || !slots::try_wait(args, children[i].second, data)) { continue; }
+
+                received[i] = true;
+                --remaining;
+                progress = true;
+
+                if constexpr(is_commutative<BinaryOp>::value) {
+                    run_t run = unpack(data);
+                    by_key::merge(keys, values, std::move(run.first), std::move(run.second), op);
+                }
+                else {
+                    pending[i] = rank_runs<run_t>::unpack(data, unpack);
+                    for(; merged < child_n && received[merged]; ++merged) {
+                        ordered.append(std::move(pending[merged]), merge);
+                    }
+                }
+            }
+
+            if(!progress) { transport::yield(); }
+        }
+
+        if constexpr(!is_commutative<BinaryOp>::value) {
+            if(rank_me == 0) {
+                run_t run = std::move(ordered).fold(merge);
+                keys = std::move(run.first);
+                values = std::move(run.second);
+            }
+        }
+
+        std::int64_t count = 0;
+        if(rank_me != 0) {
+            std::int64_t slot = 0;
+            const std::int64_t parent = tree.parent(rank_me, slot);
+            if constexpr(is_commutative<BinaryOp>::value) {
+                slots::post(args, comm.global_of_relative(parent, root), slot, serialization::pack_columns<Serialization>(keys.begin(), keys.end(), values.begin()));
+            }
+            else {
+                slots::post(args, comm.global_of_relative(parent, root), slot, ordered.pack(pack));
+            }
+        }
+        else {
+            std::move(keys.begin(), keys.end(), keys_out);
+            std::move(values.begin(), values.end(), values_out);
+            count = static_cast<std::int64_t>(keys.size());
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+        return count;
+
+    } // end operator()
+
+};
+
+} /* end namespace tree */
+
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class reduce_by_key< tree_knomial<K>, BlockingPolicy, Serialization > : public tree::reduce_by_key< knomial_schedule<K>, BlockingPolicy, Serialization > {
+public:
+    using communication_pattern = tree_knomial<K>;
+    using tree::reduce_by_key< knomial_schedule<K>, BlockingPolicy, Serialization >::reduce_by_key;
+};
+
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class reduce_by_key< tree_kary<K>, BlockingPolicy, Serialization > : public tree::reduce_by_key< kary_schedule<K>, BlockingPolicy, Serialization > {
+public:
+    using communication_pattern = tree_kary<K>;
+    using tree::reduce_by_key< kary_schedule<K>, BlockingPolicy, Serialization >::reduce_by_key;
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,143 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_REDUCE_HIERARCHICAL_HPP__
+#define __HPX_REDUCE_HIERARCHICAL_HPP__
+
+#include <string>
+#include <vector>
+#include <numeric>
+#include <sstream>
+#include <iterator>
+#include <unistd.h>
+
+#include "collective_traits.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "node_map.hpp"
+#include "hierarchical.hpp"
+#include "reduce.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// each node folds into its leader, then the leaders reduce over a binomial
+// tree relative to root; ranks are combined node by node, so op must be
+// commutative (see is_commutative)
+//
+template< typename BlockingPolicy, typename Serialization >
+class reduce< tree_hierarchical, BlockingPolicy, Serialization > {
+
+    using value_type_t = typename Serialization::value_type;
+    using serializer_t = typename Serialization::serializer;
+    using deserializer_t = typename Serialization::deserializer;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    node_map nodes;
+    mailbox< hierarchical::mailbox_t > args;
+
+    template<typename T>
+    static std::string pack(const T & value) {
+        value_type_t value_buffer{};
+        serializer_t value_oa{value_buffer};
+        value_oa << value;
+        return Serialization::get_buffer(value_buffer);
+    }
+
+    template<typename T>
+    static T unpack(const std::string & data) {
+        T value{};
+        value_type_t value_buffer{data};
+        deserializer_t value_ia{value_buffer};
+        value_ia >> value;
+        return value;
+    }
+
+public:
+    using communication_pattern = hpx::utils::collectives::tree_hierarchical;
+    using blocking_policy = BlockingPolicy;
+
+    reduce(const std::string agas_name, const std::int64_t root_=0) :
+        reduce(agas_name, communicator{}, root_) {
+    }
+
+    reduce(const std::string agas_name, const node_map & nodes_, const std::int64_t root_=0) :
+        reduce(agas_name, communicator{}, nodes_, root_) {
+    }
+
+    reduce(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0) :
+        reduce(agas_name, comm_, node_map{agas_name + "_node_map", comm_}, root_) {
+    }
+
+    // root and the ranks in nodes are ranks in comm_
+    //
+    reduce(const std::string agas_name, const communicator & comm_, const node_map & nodes_, const std::int64_t root_=0) :
+        root(root_),
+        comm(comm_),
+        nodes(nodes_),
+        args{comm.attach(agas_name, hierarchical::make_mailbox(nodes.members(nodes.node_of(comm.rank_me())).size()))} {
+    }
+
+    template<typename InputIterator, typename BinaryOp>
+    void operator()(InputIterator input_beg, InputIterator input_end, typename std::iterator_traits<InputIterator>::value_type init, BinaryOp op, typename std::iterator_traits<InputIterator>::value_type & output) {
+        static_assert(is_commutative<BinaryOp>::value, "hpx_collectives reduce: a hierarchical tree combines ranks node by node, op must be commutative");
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        const std::int64_t rank_me = comm.rank_me();
+        const hierarchical::schedule sched{nodes, root};
+
+        value_type result = std::reduce(input_beg, input_end, init, op);
+
+        if(!sched.is_leader(rank_me)) {
+            hierarchical::post_local(comm, args, sched.leader_of(rank_me), nodes.local_index(rank_me), pack(result));
+        }
+        else {
+            // fold the node, then the leader subtrees in the order the
+            // binomial tree delivers them
+            //
+            const auto & members = nodes.members(nodes.node_of(rank_me));
+            hierarchical::wait_local(args, static_cast<std::int32_t>(members.size() - 1));
+
+            bool first = true;
+            value_type node_result{};
+            for(const auto member : members) {
+                value_type member_result = (member == rank_me) ? result :
+                    unpack<value_type>(std::get<3>(*args)[nodes.local_index(member)]);
+                node_result = first ? member_result : op(node_result, member_result);
+                first = false;
+            }
+
+            result = node_result;
+
+            const std::int64_t rel = sched.relative(rank_me);
+            for(const auto & child : sched.children(rel)) {
+                const auto child_data = hierarchical::wait_tree(args, child.second);
+                result = op(result, unpack<value_type>(child_data.front()));
+            }
+
+            if(rel != 0) {
+                std::int64_t round = 0;
+                const std::int64_t parent = sched.parent(rel, round);
+                hierarchical::post_tree(comm, args, sched.leader_of_relative(parent), round, std::vector<std::string>{pack(result)});
+            }
+            else {
+                output = result;
+            }
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+    } // end operator()
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
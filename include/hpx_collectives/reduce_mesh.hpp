@@ -0,0 +1,83 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_REDUCE_MESH_HPP__
+#define __HPX_REDUCE_MESH_HPP__
+
+#include <string>
+#include <cstdint>
+#include <iterator>
+
+#include "collective_traits.hpp"
+#include "reduce.hpp"
+#include "communicator.hpp"
+#include "mesh.hpp"
+#include "reduce_tree.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// columns then row on a mesh_grid: every column reduces into its rank in
+// the root's row, all columns concurrently, then that row reduces into
+// the root, each phase a binomial tree of about sqrt(p) ranks. ranks are
+// combined column by column, so op must be commutative (see
+// is_commutative)
+//
+template< typename BlockingPolicy, typename Serialization >
+class reduce< topology_mesh, BlockingPolicy, Serialization > {
+
+private:
+    communicator comm;
+    mesh_grid grid;
+    communicator rows;
+    communicator columns;
+    reduce< tree_binomial, nonblocking, Serialization > row_phase;
+    reduce< tree_binomial, nonblocking, Serialization > column_phase;
+
+public:
+    using communication_pattern = hpx::utils::collectives::topology_mesh;
+    using blocking_policy = BlockingPolicy;
+
+    reduce(const std::string agas_name, const std::int64_t root_=0) :
+        reduce(agas_name, communicator{}, root_) {
+    }
+
+    // root is a rank in comm_
+    //
+    reduce(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0) :
+        comm(comm_),
+        grid(comm.rank_n(), root_),
+        rows(grid.row_group(comm, agas_name)),
+        columns(grid.column_group(comm, agas_name)),
+        row_phase(agas_name + "_row", rows, 0),
+        column_phase(agas_name + "_column", columns, 0) {
+    }
+
+    template<typename InputIterator, typename BinaryOp>
+    void operator()(InputIterator input_beg, InputIterator input_end, typename std::iterator_traits<InputIterator>::value_type init, BinaryOp op, typename std::iterator_traits<InputIterator>::value_type & output) {
+        static_assert(is_commutative<BinaryOp>::value, "hpx_collectives reduce: a mesh combines ranks column by column, op must be commutative");
+        // https://en.cppreference.com/w/cpp/header/iterator
+        //
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        value_type column_result{};
+        column_phase(input_beg, input_end, init, op, column_result);
+
+        // an empty range, so the column's result is folded in once
+        //
+        if(grid.row(comm.rank_me()) == 0) {
+            row_phase(input_end, input_end, column_result, op, output);
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
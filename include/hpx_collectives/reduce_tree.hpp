@@ -0,0 +1,283 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_REDUCE_TREE_HPP__
+#define __HPX_REDUCE_TREE_HPP__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <numeric>
+#include <algorithm>
+#include <iterator>
+
+#include "collective_traits.hpp"
+#include "reduce.hpp"
+#include "operators.hpp"
+#include "sparse_vector.hpp"
+#include "rank_runs.hpp"
+#include "compression.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "schedule.hpp"
+#include "slots.hpp"
+
+namespace hpx { namespace utils { namespace collectives { namespace tree {
+
+// every rank folds its children's partial results into its own and
+// sends one value to its parent; only the root's output is written
+//
+// children are polled, not waited on in turn, so a partial result is
+// deserialized as soon as it lands. a commutative op (see is_commutative)
+// folds it right away, in arrival order. any other op folds in rank
+// order: a partial result is kept as one value per run of consecutive
+// ranks (see rank_runs), each child is merged as soon as every earlier
+// one has been, and the root folds the runs at the end
+//
+template< typename Schedule, typename BlockingPolicy, typename Serialization >
+class reduce {
+
+    using mailbox_t = slots::mailbox_t<std::string>;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    mailbox<mailbox_t> args;
+
+    // folds the children's partial results into local_result, sends the
+    // sum to the parent and writes it to output on the root; pack and
+    // unpack convert a partial result to and from its wire form
+    //
+    template<typename ValueType, typename BinaryOp, typename Pack, typename Unpack>
+    void traverse(ValueType local_result, BinaryOp & op, Pack && pack, Unpack && unpack, ValueType & output) {
+        if constexpr(is_commutative<BinaryOp>::value) {
+            traverse_unordered(std::move(local_result), op, pack, unpack, output);
+        }
+        else {
+            traverse_ordered(std::move(local_result), op, pack, unpack, output);
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+    template<typename ValueType, typename BinaryOp, typename Pack, typename Unpack>
+    void traverse_unordered(ValueType local_result, BinaryOp & op, Pack & pack, Unpack & unpack, ValueType & output) {
+        const Schedule tree{comm.rank_n()};
+        const std::int64_t rank_me = comm.relative(comm.rank_me(), root);
+
+        const auto children = tree.children(rank_me);
+        const std::int64_t child_n = static_cast<std::int64_t>(children.size());
+
+        std::vector<bool> received(child_n, false);
+        std::int64_t remaining = child_n;
+        std::string data{};
+
+        while(remaining > 0) {
+            bool progress = false;
+
+            for(std::int64_t i = 0; i < child_n; ++i) {
+                if(received[i] || !slots::try_wait(args, children[i].second, data)) { continue; }
+
+                received[i] = true;
+                --remaining;
+                progress = true;
+
+                local_result = op(std::move(local_result), unpack(data));
+            }
+
+            if(!progress) { transport::yield(); }
+        }
+
+        if(rank_me != 0) {
+            std::int64_t slot = 0;
+            const std::int64_t parent = tree.parent(rank_me, slot);
+            slots::post(args, comm.global_of_relative(parent, root), slot, pack(local_result));
+        }
+        else {
+            output = std::move(local_result);
+        }
+    }
+
+    template<typename ValueType, typename BinaryOp, typename Pack, typename Unpack>
+    void traverse_ordered(ValueType local_result, BinaryOp & op, Pack & pack, Unpack & unpack, ValueType & output) {
+        const Schedule tree{comm.rank_n()};
+        const std::int64_t rank_me = comm.relative(comm.rank_me(), root);
+
+        const auto children = tree.children(rank_me);
+        const std::int64_t child_n = static_cast<std::int64_t>(children.size());
+
+        const auto merge = [&op](ValueType & lhs, ValueType && rhs) {
+            lhs = op(std::move(lhs), std::move(rhs));
+        };
+
+        rank_runs<ValueType> runs{rank_runs<ValueType>::run(tree, rank_me, root), std::move(local_result)};
+
+        std::vector<bool> received(child_n, false);
+        std::vector< rank_runs<ValueType> > pending(child_n);
+        std::int64_t remaining = child_n, folded = 0;
+        std::string data{};
+
+        while(remaining > 0) {
+            bool progress = false;
+
+            for(std::int64_t i = 0; i < child_n; ++i) {
+                if(received[i] || !slots::try_wait(args, children[i].second, data)) { continue; }
+
+                received[i] = true;
+                --remaining;
+                progress = true;
+
+                pending[i] = rank_runs<ValueType>::unpack(data, unpack);
+                for(; folded < child_n && received[folded]; ++folded) {
+                    runs.append(std::move(pending[folded]), merge);
+                }
+            }
+
+            if(!progress) { transport::yield(); }
+        }
+
+        if(rank_me != 0) {
+            std::int64_t slot = 0;
+            const std::int64_t parent = tree.parent(rank_me, slot);
+            slots::post(args, comm.global_of_relative(parent, root), slot, runs.pack(pack));
+        }
+        else {
+            output = std::move(runs).fold(merge);
+        }
+    }
+
+public:
+    using blocking_policy = BlockingPolicy;
+
+    reduce(const std::string agas_name, const std::int64_t root_=0) :
+        reduce(agas_name, communicator{}, root_) {
+    }
+
+    // root is a rank in comm_
+    //
+    reduce(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0) :
+        root(root_),
+        comm(comm_),
+        args{comm.attach(agas_name, slots::make_mailbox<std::string>(Schedule{comm.rank_n()}.slot_n()))} {
+    }
+
+    template<typename InputIterator, typename BinaryOp>
+    void operator()(InputIterator input_beg, InputIterator input_end, typename std::iterator_traits<InputIterator>::value_type init, BinaryOp op, typename std::iterator_traits<InputIterator>::value_type & output) {
+        // https://en.cppreference.com/w/cpp/header/iterator
+        //
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        traverse(value_type{std::reduce(input_beg, input_end, init, op)}, op,
+            [](const value_type & value) { return serialization::pack<Serialization>(value); },
+            [](const std::string & data) { return serialization::unpack<Serialization, value_type>(data); },
+            output);
+
+    } // end operator()
+
+    // fused reduce: one traversal computes one result per op, element i of
+    // output reducing transform i of every input element with op i, from
+    // element i of init
+    //
+    //     r(beg, end, std::make_tuple(0.0, lo, hi, 0L),
+    //         std::make_tuple(std::plus<double>{}, minimum<>{}, maximum<>{}, std::plus<long>{}),
+    //         std::make_tuple(identity{}, identity{}, identity{}, [](double) { return 1L; }),
+    //         stats);
+    //
+    template<typename InputIterator, typename... Ts, typename... BinaryOps, typename... Transforms>
+    void operator()(InputIterator input_beg, InputIterator input_end, std::tuple<Ts...> init, std::tuple<BinaryOps...> ops, std::tuple<Transforms...> transforms, std::tuple<Ts...> & output) {
+        static_assert(sizeof...(Ts) == sizeof...(BinaryOps) && sizeof...(Ts) == sizeof...(Transforms), "fused reduce: one init, op and transform per result");
+
+        fused<BinaryOps...> op{std::move(ops)};
+
+        std::tuple<Ts...> local_result{std::move(init)};
+        for(auto itr = input_beg; itr != input_end; ++itr) {
+            op.fold(local_result, transforms, *itr);
+        }
+
+        traverse(std::move(local_result), op,
+            [](const std::tuple<Ts...> & value) { return serialization::pack_tuple<Serialization>(value); },
+            [](const std::string & data) { return serialization::unpack_tuple<Serialization, Ts...>(data); },
+            output);
+    }
+
+    // fused reduce without transforms
+    //
+    template<typename InputIterator, typename... Ts, typename... BinaryOps>
+    void operator()(InputIterator input_beg, InputIterator input_end, std::tuple<Ts...> init, std::tuple<BinaryOps...> ops, std::tuple<Ts...> & output) {
+        (*this)(input_beg, input_end, std::move(init), std::move(ops), transforms_of(std::index_sequence_for<Ts...>{}), output);
+    }
+
+    // sparse reduce: the root gets the element-wise op of every rank's
+    // vector. a link carries the nonzeros of its subtree for as long as
+    // the partial result stays sparse
+    //
+    template<typename Value, typename BinaryOp>
+    void operator()(const sparse_vector<Value> & input, BinaryOp op, sparse_vector<Value> & output) {
+        sparse_merge<BinaryOp> merge{std::move(op)};
+
+        traverse(sparse_vector<Value>{input}, merge,
+            [](const sparse_vector<Value> & value) { return serialization::pack<Serialization>(value); },
+            [](const std::string & data) { return serialization::unpack<Serialization, sparse_vector<Value>>(data); },
+            output);
+    }
+
+    // element-wise reduce of equal length float or double ranges over a
+    // 16 bit wire: every rank sends its partial result quantized by
+    // codec and folds what it receives in full precision. the root writes
+    // the result to out_beg. op must be commutative (see is_commutative):
+    // a rank sends a single partial result, so its error feedback maps
+    // onto the same elements every call
+    //
+    template<typename InputIterator, typename OutputIterator, typename BinaryOp, typename Format>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg, BinaryOp op, quantizer<Format> & codec) {
+        static_assert(is_commutative<BinaryOp>::value, "hpx_collectives reduce: quantized partial results share one error feedback residual, op must be commutative");
+        // https://en.cppreference.com/w/cpp/header/iterator
+        //
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        elementwise<BinaryOp> merge{std::move(op)};
+        std::vector<value_type> result{};
+
+        traverse(std::vector<value_type>(input_beg, input_end), merge,
+            [&codec](const std::vector<value_type> & value) { return serialization::pack<Serialization>(codec.encode(value)); },
+            [&codec](const std::string & data) { return codec.template decode<value_type>(serialization::unpack<Serialization, std::vector<std::uint16_t>>(data)); },
+            result);
+
+        std::copy(result.begin(), result.end(), out_beg);
+    }
+
+private:
+    template<std::size_t... I>
+    static auto transforms_of(std::index_sequence<I...>) {
+        return std::make_tuple(((void)I, identity{})...);
+    }
+
+};
+
+} /* end namespace tree */
+
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class reduce< tree_knomial<K>, BlockingPolicy, Serialization > : public tree::reduce< knomial_schedule<K>, BlockingPolicy, Serialization > {
+public:
+    using communication_pattern = tree_knomial<K>;
+    using tree::reduce< knomial_schedule<K>, BlockingPolicy, Serialization >::reduce;
+};
+
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class reduce< tree_kary<K>, BlockingPolicy, Serialization > : public tree::reduce< kary_schedule<K>, BlockingPolicy, Serialization > {
+public:
+    using communication_pattern = tree_kary<K>;
+    using tree::reduce< kary_schedule<K>, BlockingPolicy, Serialization >::reduce;
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
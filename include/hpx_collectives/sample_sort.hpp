@@ -0,0 +1,206 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_SAMPLE_SORT_HPP__
+#define __HPX_SAMPLE_SORT_HPP__
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+#include "collective_traits.hpp"
+#include "communicator.hpp"
+#include "radix_sort.hpp"
+#include "gatherv_binomial.hpp"
+#include "broadcast_tree.hpp"
+#include "alltoallv_pairwise.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// what one sample_sort call did on this rank; keys_per_second is the
+// rank's input over the whole call, the figure to compare across
+// localities and runs
+//
+struct sort_stats {
+    std::int64_t keys_in;
+    std::int64_t keys_out;
+    double local_sort;
+    double splitters;
+    double exchange;
+    double merge;
+
+    double seconds() const { return local_sort + splitters + exchange + merge; }
+
+    double keys_per_second() const {
+        const double total = seconds();
+        return (total > 0.0) ? (static_cast<double>(keys_in) / total) : 0.0;
+    }
+};
+
+// distributed sample sort: afterwards every rank holds a sorted run and
+// the runs are in rank order
+//
+//     1. every rank sorts its keys
+//     2. every rank picks samples_per_rank evenly spaced keys; rank 0
+//        gathers them, picks rank_n - 1 evenly spaced splitters and
+//        broadcasts them
+//     3. every rank sends the keys between splitters r - 1 and r to rank r
+//        (all-to-allv, pairwise)
+//     4. every rank merges the sorted runs it received
+//
+// integer and IEEE 754 floating point keys of 1, 2, 4 or 8 bytes under
+// std::less sort by radix in steps 1 and 4 (see radix::is_sortable),
+// anything else with std::sort and std::inplace_merge. keys equal
+// to a splitter all go to the same rank, so heavily repeated keys can
+// unbalance the result
+//
+template< typename BlockingPolicy, typename Serialization >
+class sample_sort {
+
+private:
+    communicator comm;
+    std::int64_t samples_per_rank;
+    gatherv< tree_binomial, nonblocking, Serialization > sample_gather;
+    broadcast< tree_binomial, nonblocking, Serialization > splitter_broadcast;
+    alltoallv< topology_pairwise, nonblocking, Serialization > exchange;
+
+    template<typename Key, typename Compare>
+    static void local_sort(std::vector<Key> & keys, Compare & comp) {
+        if constexpr(radix::is_sortable<Key>::value && radix::is_ascending<Key, Compare>::value) {
+            radix::sort(keys);
+        }
+        else {
+            std::sort(keys.begin(), keys.end(), comp);
+        }
+    }
+
+    // merges the sorted runs of the given lengths, pairwise, in log2
+    // runs passes
+    //
+    template<typename Key, typename Compare>
+    static void merge_runs(std::vector<Key> & keys, std::vector<std::int64_t> bounds, Compare & comp) {
+        if constexpr(radix::is_sortable<Key>::value && radix::is_ascending<Key, Compare>::value) {
+            radix::sort(keys);
+        }
+        else {
+            while(bounds.size() > 2) {
+                std::vector<std::int64_t> merged{0};
+                for(std::size_t i = 0; (i + 1) < bounds.size(); i += 2) {
+                    if((i + 2) < bounds.size()) {
+                        std::inplace_merge(keys.begin() + bounds[i], keys.begin() + bounds[i + 1], keys.begin() + bounds[i + 2], comp);
+                        merged.push_back(bounds[i + 2]);
+                    }
+                    else {
+                        merged.push_back(bounds[i + 1]);
+                    }
+                }
+                bounds = std::move(merged);
+            }
+        }
+    }
+
+    static double since(const std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+public:
+    using blocking_policy = BlockingPolicy;
+
+    sample_sort(const std::string agas_name, const std::int64_t samples_per_rank_=128) :
+        sample_sort(agas_name, communicator{}, samples_per_rank_) {
+    }
+
+    // samples_per_rank must agree on every rank; more samples balance the
+    // result better at the cost of a larger gather on rank 0
+    //
+    sample_sort(const std::string agas_name, const communicator & comm_, const std::int64_t samples_per_rank_=128) :
+        comm(comm_),
+        samples_per_rank(std::max(samples_per_rank_, std::int64_t{1})),
+        sample_gather(agas_name + "_samples", comm, 0),
+        splitter_broadcast(agas_name + "_splitters", comm, 0),
+        exchange(agas_name + "_exchange", comm) {
+    }
+
+    // sorts keys across the communicator in place: keys is replaced by
+    // this rank's run of the sorted whole
+    //
+    template<typename Key, typename Compare = std::less<>>
+    sort_stats operator()(std::vector<Key> & keys, Compare comp = Compare{}) {
+        const std::int64_t rank_n = comm.rank_n();
+        sort_stats stats{static_cast<std::int64_t>(keys.size()), 0, 0.0, 0.0, 0.0, 0.0};
+
+        auto start = std::chrono::steady_clock::now();
+        local_sort(keys, comp);
+        stats.local_sort = since(start);
+
+        start = std::chrono::steady_clock::now();
+        const std::int64_t n = static_cast<std::int64_t>(keys.size());
+        const std::int64_t sample_n = std::min(samples_per_rank, n);
+
+        std::vector<Key> samples{};
+        samples.reserve(sample_n);
+        for(std::int64_t i = 0; i < sample_n; ++i) {
+            samples.push_back(keys[((i + 1) * n) / (sample_n + 1)]);
+        }
+
+        std::vector<Key> all_samples{};
+        sample_gather(samples.begin(), samples.end(), std::back_inserter(all_samples));
+
+        std::vector<Key> splitters{};
+        if(comm.rank_me() == 0) {
+            std::sort(all_samples.begin(), all_samples.end(), comp);
+            const std::int64_t all_n = static_cast<std::int64_t>(all_samples.size());
+            if(all_n > 0) {
+                for(std::int64_t rank = 1; rank < rank_n; ++rank) {
+                    splitters.push_back(all_samples[std::min((rank * all_n) / rank_n, all_n - 1)]);
+                }
+            }
+        }
+        splitter_broadcast(splitters);
+        stats.splitters = since(start);
+
+        start = std::chrono::steady_clock::now();
+        std::vector<std::int64_t> counts(rank_n, 0);
+        {
+            std::int64_t first = 0;
+            for(std::int64_t rank = 0; rank < rank_n; ++rank) {
+                const std::int64_t last = (rank < static_cast<std::int64_t>(splitters.size())) ?
+                    static_cast<std::int64_t>(std::upper_bound(keys.begin() + first, keys.end(), splitters[rank], comp) - keys.begin()) :
+                    n;
+                counts[rank] = last - first;
+                first = last;
+            }
+        }
+
+        std::vector<Key> received{};
+        const std::vector<std::int64_t> received_counts = exchange(keys.begin(), keys.end(), counts, std::back_inserter(received));
+        stats.exchange = since(start);
+
+        start = std::chrono::steady_clock::now();
+        std::vector<std::int64_t> bounds{0};
+        for(const std::int64_t count : received_counts) { bounds.push_back(bounds.back() + count); }
+        merge_runs(received, std::move(bounds), comp);
+        keys = std::move(received);
+        stats.merge = since(start);
+
+        stats.keys_out = static_cast<std::int64_t>(keys.size());
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+        return stats;
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,275 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_SCATTER_DYNAMIC_HPP__
+#define __HPX_SCATTER_DYNAMIC_HPP__
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "collective_traits.hpp"
+#include "distribution.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "mailbox.hpp"
+#include "utils.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// the work queue the root exposes during a scatter_dynamic call; requests
+// are answered by the handler that delivers them, so the root's own
+// thread never stops working to hand out chunks
+//
+class dynamic_queue {
+
+public:
+    std::mutex mtx;
+    std::int64_t generation = 0;
+    bool open = false;
+    std::int64_t n = 0;
+    std::int64_t next = 0;
+    std::int64_t finished = 0;
+    std::function<std::int64_t(std::int64_t)> chunk;
+    std::function<std::string(std::int64_t, std::int64_t)> pack;
+
+    // (requester, generation) of requests that arrived before the call
+    // they belong to was opened
+    //
+    std::vector< std::pair<std::int64_t, std::int64_t> > parked;
+
+    // the next chunk as (first, count) under the lock; a count of 0 means
+    // the work is exhausted, and the requester is counted as finished
+    //
+    std::pair<std::int64_t, std::int64_t> take() {
+        if(next >= n) {
+            ++finished;
+            return std::make_pair(n, std::int64_t{0});
+        }
+
+        const std::int64_t count = chunk(n - next);
+        const std::int64_t first = next;
+        next += count;
+        return std::make_pair(first, count);
+    }
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+REGISTER_DISTRIBUTED_OBJECT_PART(std::tuple<std::vector<std::int32_t>, std::vector<std::string>, std::shared_ptr<hpx::utils::collectives::dynamic_queue>>);
+
+namespace hpx { namespace utils { namespace collectives {
+
+// self-scheduling scatter for work of uneven cost: the root exposes its
+// range as a queue of chunks sized by ChunkPolicy (guided_chunks,
+// factoring_chunks, fixed_chunks) and every rank, the root included,
+// pulls the next chunk whenever it has processed the last one, so fast
+// ranks take more chunks than slow ones
+//
+// a request is a small message to the root; the root's delivery handler
+// takes the chunk and sends it back, without the root's thread. once the
+// queue is exhausted every request is answered with an empty reply, which
+// ends the call on that rank, and the root returns after every rank has
+// been told
+//
+// process(chunk, offset) is called with each chunk as a vector and the
+// offset of its first element in the root's range
+//
+template< typename ValueType, typename BlockingPolicy, typename Serialization, typename ChunkPolicy = guided_chunks >
+class scatter_dynamic {
+
+    // 0: reply flag
+    // 1: reply, the chunk's offset then its elements; empty once the
+    //    work is exhausted
+    // 2: the work queue, used on the root
+    //
+    using mailbox_t = std::tuple< std::vector<std::int32_t>, std::vector<std::string>, std::shared_ptr<dynamic_queue> >;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    ChunkPolicy policy;
+    std::int64_t generation;
+    mailbox<mailbox_t> args;
+
+    static std::string reply(dynamic_queue & queue, const std::pair<std::int64_t, std::int64_t> & taken) {
+        if(taken.second == 0) { return std::string{}; }
+
+        std::string data(sizeof(std::int64_t), '\0');
+        std::memcpy(&data[0], &taken.first, sizeof(std::int64_t));
+        data.append(queue.pack(taken.first, taken.second));
+        return data;
+    }
+
+    static void respond(mailbox<mailbox_t> & args_, const std::int64_t requester, std::string data) {
+        args_.post(
+            requester,
+            [](mailbox<mailbox_t> & args__, std::string data_) {
+                std::get<1>(*args__)[0] = std::move(data_);
+                atomic_xchange( &std::get<0>(*args__)[0], 0, 1 );
+            }, std::move(data)
+        );
+    }
+
+    // runs on the root, in the handler delivering the request
+    //
+    static void serve(mailbox<mailbox_t> & args_, const std::int64_t requester, const std::int64_t generation_) {
+        dynamic_queue & queue = *std::get<2>(*args_);
+
+        std::pair<std::int64_t, std::int64_t> taken{};
+        {
+            std::lock_guard<std::mutex> lock(queue.mtx);
+            if(!queue.open || queue.generation != generation_) {
+                queue.parked.emplace_back(requester, generation_);
+                return;
+            }
+            taken = queue.take();
+        }
+
+        respond(args_, requester, reply(queue, taken));
+    }
+
+    template<typename Process>
+    std::int64_t work(Process & process) {
+        const std::int64_t rank_root = comm.global(root);
+        std::int64_t processed = 0;
+
+        while(true) {
+            args.post(
+                rank_root,
+                [](mailbox<mailbox_t> & args_, std::int64_t requester, std::int64_t generation_) {
+                    serve(args_, requester, generation_);
+                }, comm.global(comm.rank_me()), generation
+            );
+
+            while(!atomic_xchange( &std::get<0>(*args)[0], 1, 0 )) { transport::yield(); }
+            const std::string data = std::move(std::get<1>(*args)[0]);
+            if(data.empty()) { break; }
+
+            std::int64_t offset = 0, count = 0;
+            std::memcpy(&offset, data.data(), sizeof(std::int64_t));
+
+            std::vector<ValueType> chunk{};
+            serialization::unpack_values<Serialization, ValueType>(data.substr(sizeof(std::int64_t)), std::back_inserter(chunk), count);
+
+            process(chunk, offset);
+            processed += count;
+        }
+
+        return processed;
+    }
+
+public:
+    using blocking_policy = BlockingPolicy;
+
+    scatter_dynamic(const std::string agas_name, const std::int64_t root_=0, const ChunkPolicy & policy_ = ChunkPolicy{}) :
+        scatter_dynamic(agas_name, communicator{}, root_, policy_) {
+    }
+
+    // root is a rank in comm_; only the root's policy is used
+    //
+    scatter_dynamic(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0, const ChunkPolicy & policy_ = ChunkPolicy{}) :
+        root(root_),
+        comm(comm_),
+        policy(policy_),
+        generation(0),
+        args{comm.attach(agas_name, std::make_tuple(std::vector<std::int32_t>(1, 0), std::vector<std::string>(1), std::make_shared<dynamic_queue>()))} {
+    }
+
+    // root; the range must stay valid until the call returns, and every
+    // rank, the root included, processes chunks of it. returns the number
+    // of elements this rank processed
+    //
+    template<typename InputIterator, typename Process>
+    std::int64_t operator()(InputIterator input_beg, InputIterator input_end, Process process) {
+        static_assert(std::is_same<typename std::iterator_traits<InputIterator>::value_type, ValueType>::value, "scatter_dynamic: the range must hold ValueType elements");
+
+        if(comm.rank_me() != root) {
+            throw std::logic_error("hpx_collectives scatter_dynamic: only the root passes a range");
+        }
+
+        dynamic_queue & queue = *std::get<2>(*args);
+        std::vector< std::pair<std::int64_t, std::int64_t> > parked{};
+        {
+            std::lock_guard<std::mutex> lock(queue.mtx);
+            queue.generation = generation;
+            queue.n = static_cast<std::int64_t>(std::distance(input_beg, input_end));
+            queue.next = 0;
+            queue.finished = 0;
+
+            policy.reset(queue.n, comm.rank_n());
+            queue.chunk = [this](const std::int64_t remaining) { return policy.next(remaining); };
+            queue.pack = [input_beg](const std::int64_t first, const std::int64_t count) {
+                return serialization::pack_values<Serialization>(std::next(input_beg, first), count);
+            };
+
+            queue.open = true;
+            std::swap(parked, queue.parked);
+        }
+
+        for(const auto & request : parked) {
+            serve(args, request.first, request.second);
+        }
+
+        const std::int64_t processed = work(process);
+
+        // every rank has been told the work is exhausted, the root last
+        //
+        while(true) {
+            {
+                std::lock_guard<std::mutex> lock(queue.mtx);
+                if(queue.finished == comm.rank_n()) {
+                    queue.open = false;
+                    queue.chunk = nullptr;
+                    queue.pack = nullptr;
+                    break;
+                }
+            }
+            transport::yield();
+        }
+
+        ++generation;
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+        return processed;
+    }
+
+    // every rank but the root
+    //
+    template<typename Process>
+    std::int64_t operator()(Process process) {
+        if(comm.rank_me() == root) {
+            throw std::logic_error("hpx_collectives scatter_dynamic: the root must pass a range");
+        }
+
+        const std::int64_t processed = work(process);
+        ++generation;
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+        return processed;
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,155 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_SCATTER_HIERARCHICAL_HPP__
+#define __HPX_SCATTER_HIERARCHICAL_HPP__
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <unistd.h>
+
+#include "collective_traits.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "node_map.hpp"
+#include "hierarchical.hpp"
+#include "scatter.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+template< typename BlockingPolicy, typename Serialization >
+class scatter< tree_hierarchical, BlockingPolicy, Serialization > {
+
+    using value_type_t = typename Serialization::value_type;
+    using serializer_t = typename Serialization::serializer;
+    using deserializer_t = typename Serialization::deserializer;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    node_map nodes;
+    mailbox< hierarchical::mailbox_t > args;
+
+public:
+    using communication_pattern = hpx::utils::collectives::tree_hierarchical;
+    using blocking_policy = BlockingPolicy;
+
+    scatter(const std::string agas_name, const std::int64_t root_=0) :
+        scatter(agas_name, communicator{}, root_) {
+    }
+
+    scatter(const std::string agas_name, const node_map & nodes_, const std::int64_t root_=0) :
+        scatter(agas_name, communicator{}, nodes_, root_) {
+    }
+
+    scatter(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0) :
+        scatter(agas_name, comm_, node_map{agas_name + "_node_map", comm_}, root_) {
+    }
+
+    // root and the ranks in nodes are ranks in comm_
+    //
+    scatter(const std::string agas_name, const communicator & comm_, const node_map & nodes_, const std::int64_t root_=0) :
+        root(root_),
+        comm(comm_),
+        nodes(nodes_),
+        args{comm.attach(agas_name, hierarchical::make_mailbox(nodes.members(nodes.node_of(comm.rank_me())).size()))} {
+    }
+
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg) {
+        const std::int64_t rank_me = comm.rank_me();
+        const std::int64_t rank_n = comm.rank_n();
+        const hierarchical::schedule sched{nodes, root};
+        const std::int64_t leader_n = sched.leader_n();
+
+        // blocks are laid out node by node in relative leader order, so
+        // every leader subtree owns one contiguous run of them
+        //
+        std::vector<std::int64_t> offsets(leader_n + 1, 0);
+        for(std::int64_t rel = 0; rel < leader_n; ++rel) {
+            offsets[rel + 1] = offsets[rel] + static_cast<std::int64_t>(nodes.members(sched.node_of_relative(rel)).size());
+        }
+
+        const std::int64_t rel_me = sched.relative(rank_me);
+        std::vector<std::string> blocks{};
+
+        if(rank_me == root) {
+            const std::int64_t block_size = static_cast<std::int64_t>(input_end - input_beg) / rank_n;
+
+            blocks.reserve(rank_n);
+            for(std::int64_t rel = 0; rel < leader_n; ++rel) {
+                for(const auto member : nodes.members(sched.node_of_relative(rel))) {
+                    value_type_t value_buffer{};
+                    serializer_t value_oa{value_buffer};
+
+                    value_oa << block_size;
+                    if(member != root) {
+                        auto seg_itr = input_beg + (member * block_size);
+                        for(std::int64_t i = 0; i < block_size; ++i, ++seg_itr) {
+                            value_oa << (*seg_itr);
+                        }
+                    }
+
+                    blocks.push_back(Serialization::get_buffer(value_buffer));
+                }
+            }
+
+            std::copy(input_beg + (root * block_size), input_beg + ((root + 1) * block_size), out_beg);
+        }
+        else {
+            blocks = hierarchical::wait_down(args);
+        }
+
+        if(sched.is_leader(rank_me)) {
+            // blocks[0] is the first block of this leader's node, which
+            // is also the leader's own block unless it is the root
+            //
+            const std::int64_t base = offsets[rel_me];
+
+            const auto children = sched.children(rel_me);
+            for(auto child = children.rbegin(); child != children.rend(); ++child) {
+                const std::int64_t child_end = child->first + sched.subtree_n(child->first);
+                hierarchical::post_down(comm, args, sched.leader_of_relative(child->first),
+                    std::vector<std::string>(
+                        std::make_move_iterator(blocks.begin() + (offsets[child->first] - base)),
+                        std::make_move_iterator(blocks.begin() + (offsets[child_end] - base))
+                    )
+                );
+            }
+
+            for(const auto member : nodes.members(nodes.node_of(rank_me))) {
+                if(member != rank_me) {
+                    hierarchical::post_down(comm, args, member, std::vector<std::string>{std::move(blocks[nodes.local_index(member)])});
+                }
+            }
+        }
+
+        if(rank_me != root) {
+            value_type_t value_buffer{blocks.front()};
+            deserializer_t value_ia{value_buffer};
+
+            std::int64_t element_count = 0;
+            value_ia >> element_count;
+            for(std::int64_t i = 0; i < element_count; ++i) {
+                value_ia >> (*out_beg++);
+            }
+        }
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+    } // end operator()
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
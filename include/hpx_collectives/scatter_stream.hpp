@@ -0,0 +1,197 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_SCATTER_STREAM_HPP__
+#define __HPX_SCATTER_STREAM_HPP__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "collective_traits.hpp"
+#include "distribution.hpp"
+#include "stream_source.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "slots.hpp"
+#include "utils.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// scatters a source of ValueType records (a mapped_file, a file_reader or
+// any chunked reader) that only the root holds; the root reads each
+// rank's block in chunk_bytes pieces and sends them straight to the
+// owner, with at most window chunks unacknowledged at a time, so neither
+// the root nor the receivers ever hold more than a few chunks whatever
+// the size of the source
+//
+// records are copied as raw bytes, so ValueType must be trivially
+// copyable, and a trailing partial record in the source is ignored
+//
+template< typename ValueType, typename BlockingPolicy >
+class scatter_stream {
+
+    static_assert(std::is_trivially_copyable<ValueType>::value, "scatter_stream moves records as raw bytes");
+
+    using mailbox_t = slots::mailbox_t<std::string>;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    std::int64_t chunk_n, window;
+    std::int64_t sent;
+    mailbox<mailbox_t> args;
+
+    // slots 0 .. window - 1: chunks, by sequence number modulo window
+    // slot window: record count of this rank's block
+    // slot window + 1: acknowledgements, counted on the root
+    //
+    std::int64_t count_slot() const { return window; }
+    std::int64_t ack_slot() const { return window + 1; }
+
+    std::int64_t acked() {
+        return __atomic_load_n(&std::get<0>(*args)[ack_slot()], __ATOMIC_ACQUIRE);
+    }
+
+    void send(const std::int64_t target, std::string && data, const std::int64_t slot) {
+        // every earlier chunk to target up to sequence - window has been
+        // consumed once fewer than window chunks are unacknowledged, since
+        // targets consume in order
+        //
+        while((sent - acked()) >= window) { transport::yield(); }
+        ++sent;
+        slots::post(args, target, slot, std::move(data));
+    }
+
+    template<typename OutputIterator>
+    OutputIterator emit(const char * data, const std::int64_t records, OutputIterator out_beg) {
+        for(std::int64_t i = 0; i < records; ++i, ++out_beg) {
+            ValueType value;
+            std::memcpy(&value, data + (i * sizeof(ValueType)), sizeof(ValueType));
+            *out_beg = value;
+        }
+        return out_beg;
+    }
+
+    template<typename OutputIterator>
+    void receive(OutputIterator out_beg) {
+        const std::int64_t rank_root = comm.global(root);
+
+        std::string count_data = slots::wait(args, count_slot());
+        std::int64_t records = 0;
+        std::memcpy(&records, count_data.data(), sizeof(records));
+        acknowledge(rank_root);
+
+        for(std::int64_t seq = 0; records > 0; ++seq) {
+            const std::string chunk = slots::wait(args, seq % window);
+            const std::int64_t chunk_records = static_cast<std::int64_t>(chunk.size() / sizeof(ValueType));
+            out_beg = emit(chunk.data(), chunk_records, out_beg);
+            records -= chunk_records;
+            acknowledge(rank_root);
+        }
+    }
+
+    void acknowledge(const std::int64_t rank_root) {
+        args.post(
+            rank_root,
+            [](mailbox<mailbox_t> & args_, std::int64_t slot_) {
+                __atomic_add_fetch( &std::get<0>(*args_)[slot_], 1, __ATOMIC_ACQ_REL );
+            }, ack_slot()
+        );
+    }
+
+public:
+    using blocking_policy = BlockingPolicy;
+
+    scatter_stream(const std::string agas_name, const std::int64_t root_=0) :
+        scatter_stream(agas_name, communicator{}, root_) {
+    }
+
+    // root is a rank in comm_; chunk_bytes and window must agree on
+    // every rank
+    //
+    scatter_stream(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0, const std::int64_t chunk_bytes=(1 << 20), const std::int64_t window_=8) :
+        root(root_),
+        comm(comm_),
+        chunk_n(std::max(chunk_bytes / static_cast<std::int64_t>(sizeof(ValueType)), std::int64_t{1})),
+        window(std::max(window_, std::int64_t{1})),
+        sent(0),
+        args{comm.attach(agas_name, slots::make_mailbox<std::string>(window + 2))} {
+    }
+
+    // root; rank r receives its block of the source's records under the
+    // distribution policy
+    //
+    template<typename Source, typename OutputIterator, typename DistributionPolicy = balanced_distribution>
+    void operator()(Source & source, OutputIterator out_beg, const DistributionPolicy & policy = DistributionPolicy{}) {
+        if(comm.rank_me() != root) {
+            throw std::logic_error("hpx_collectives scatter_stream: only the root passes a source");
+        }
+
+        const std::int64_t rank_n = comm.rank_n();
+        const std::int64_t record_bytes = static_cast<std::int64_t>(sizeof(ValueType));
+        const std::vector<std::int64_t> counts = policy.counts(source.size() / record_bytes, rank_n);
+        const std::vector<std::int64_t> displs = displacements(counts);
+
+        for(std::int64_t rank = 0; rank < rank_n; ++rank) {
+            if(rank != root) {
+                std::string count_data(sizeof(std::int64_t), '\0');
+                std::memcpy(&count_data[0], &counts[rank], sizeof(std::int64_t));
+                send(comm.global(rank), std::move(count_data), count_slot());
+            }
+
+            std::int64_t seq = 0;
+            for(std::int64_t first = 0; first < counts[rank]; first += chunk_n, ++seq) {
+                const std::int64_t records = std::min(chunk_n, counts[rank] - first);
+
+                std::string chunk(records * record_bytes, '\0');
+                source.read((displs[rank] + first) * record_bytes, &chunk[0], records * record_bytes);
+
+                if(rank == root) {
+                    out_beg = emit(chunk.data(), records, out_beg);
+                }
+                else {
+                    send(comm.global(rank), std::move(chunk), seq % window);
+                }
+            }
+        }
+
+        // every slot is free again before the next call
+        //
+        while(acked() < sent) { transport::yield(); }
+        __atomic_sub_fetch( &std::get<0>(*args)[ack_slot()], static_cast<std::int32_t>(sent), __ATOMIC_ACQ_REL );
+        sent = 0;
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+    // every rank but the root
+    //
+    template<typename OutputIterator>
+    void operator()(OutputIterator out_beg) {
+        if(comm.rank_me() == root) {
+            throw std::logic_error("hpx_collectives scatter_stream: the root must pass a source");
+        }
+
+        receive(out_beg);
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,120 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_SCATTER_TREE_HPP__
+#define __HPX_SCATTER_TREE_HPP__
+
+#include <string>
+#include <cstdint>
+#include <iterator>
+
+#include "collective_traits.hpp"
+#include "scatter.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "schedule.hpp"
+#include "slots.hpp"
+#include "packed_blocks.hpp"
+
+namespace hpx { namespace utils { namespace collectives { namespace tree {
+
+// the root packs every rank's block once into one packed_blocks buffer,
+// in the schedule's buffer order; the blocks of a subtree are then
+// contiguous, so every node forwards each child the byte range holding
+// that child's subtree, without unpacking or repacking it
+//
+template< typename Schedule, typename BlockingPolicy, typename Serialization >
+class scatter {
+
+    using mailbox_t = slots::mailbox_t<packed_blocks>;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    mailbox<mailbox_t> args;
+
+public:
+    using blocking_policy = BlockingPolicy;
+
+    scatter(const std::string agas_name, const std::int64_t root_=0) :
+        scatter(agas_name, communicator{}, root_) {
+    }
+
+    // root is a rank in comm_
+    //
+    scatter(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0) :
+        root(root_),
+        comm(comm_),
+        args{comm.attach(agas_name, slots::make_mailbox<packed_blocks>(1))} {
+    }
+
+    // rank r receives the r-th of rank_n equal blocks of the root's input
+    //
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg) {
+        // https://en.cppreference.com/w/cpp/header/iterator
+        //
+        using value_type_t = typename std::iterator_traits<InputIterator>::value_type;
+
+        const std::int64_t rank_n = comm.rank_n();
+        const std::int64_t rank_me = comm.relative(comm.rank_me(), root);
+        const Schedule tree{rank_n};
+
+        // block i belongs to tree.order(rank_me)[i]
+        //
+        packed_blocks blocks{};
+
+        if(rank_me == 0) {
+            const auto block_size = static_cast<std::int64_t>(input_end - input_beg) /
+                static_cast<std::int64_t>(rank_n);
+
+            blocks.reserve(rank_n, 0);
+            for(const std::int64_t rel : tree.order(0)) {
+                const auto block_beg = input_beg + (((rel + root) % rank_n) * block_size);
+                blocks.append<Serialization>(block_beg, block_beg + block_size);
+            }
+        }
+        else {
+            blocks = slots::wait(args, 0);
+        }
+
+        std::int64_t first = 1;
+        for(const auto & child : tree.children(rank_me)) {
+            const std::int64_t last = first + tree.subtree_n(child.first);
+            blocks.slice(first, last).post(args, comm.global_of_relative(child.first, root), 0);
+            first = last;
+        }
+
+        blocks.unpack<Serialization, value_type_t>(0, out_beg);
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+
+    } // end operator()
+
+};
+
+} /* end namespace tree */
+
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class scatter< tree_knomial<K>, BlockingPolicy, Serialization > : public tree::scatter< knomial_schedule<K>, BlockingPolicy, Serialization > {
+public:
+    using communication_pattern = tree_knomial<K>;
+    using tree::scatter< knomial_schedule<K>, BlockingPolicy, Serialization >::scatter;
+};
+
+template< std::int64_t K, typename BlockingPolicy, typename Serialization >
+class scatter< tree_kary<K>, BlockingPolicy, Serialization > : public tree::scatter< kary_schedule<K>, BlockingPolicy, Serialization > {
+public:
+    using communication_pattern = tree_kary<K>;
+    using tree::scatter< kary_schedule<K>, BlockingPolicy, Serialization >::scatter;
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,127 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_SCATTERV_BINOMIAL_HPP__
+#define __HPX_SCATTERV_BINOMIAL_HPP__
+
+#include <string>
+#include <vector>
+#include <iterator>
+#include <stdexcept>
+
+#include "collective_traits.hpp"
+#include "scatterv.hpp"
+#include "distribution.hpp"
+#include "serialization.hpp"
+#include "transport.hpp"
+#include "communicator.hpp"
+#include "slots.hpp"
+#include "packed_blocks.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// the root packs every rank's block once into one packed_blocks buffer;
+// a binomial subtree covers a contiguous range of relative ranks, so each
+// child is sent the byte range holding its subtree's blocks and nothing
+// else
+//
+template< typename BlockingPolicy, typename Serialization >
+class scatterv< tree_binomial, BlockingPolicy, Serialization > {
+
+    using mailbox_t = slots::mailbox_t<packed_blocks>;
+
+private:
+    std::int64_t root;
+    communicator comm;
+    mailbox<mailbox_t> args;
+
+public:
+    using communication_pattern = hpx::utils::collectives::tree_binomial;
+    using blocking_policy = BlockingPolicy;
+
+    scatterv(const std::string agas_name, const std::int64_t root_=0) :
+        scatterv(agas_name, communicator{}, root_) {
+    }
+
+    // root is a rank in comm_
+    //
+    scatterv(const std::string agas_name, const communicator & comm_, const std::int64_t root_=0) :
+        root(root_),
+        comm(comm_),
+        args{comm.attach(agas_name, slots::make_mailbox<packed_blocks>(1))} {
+    }
+
+    // rank r receives counts[r] elements starting at input_beg + displs[r];
+    // the input, counts and displs are only read on the root
+    //
+    template<typename InputIterator, typename OutputIterator>
+    void operator()(InputIterator input_beg, InputIterator input_end, const std::vector<std::int64_t> & counts, const std::vector<std::int64_t> & displs, OutputIterator out_beg) {
+        using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+        const std::int64_t rank_n = comm.rank_n();
+        const std::int64_t rank_me = comm.relative(comm.rank_me(), root);
+        const binomial_schedule tree = comm.schedule();
+
+        // block i belongs to relative rank rank_me + i
+        //
+        packed_blocks blocks{};
+
+        if(rank_me == 0) {
+            if(static_cast<std::int64_t>(counts.size()) != rank_n || static_cast<std::int64_t>(displs.size()) != rank_n) {
+                throw std::length_error("hpx_collectives scatterv: one count and displacement per rank expected");
+            }
+
+            const std::int64_t input_n = static_cast<std::int64_t>(std::distance(input_beg, input_end));
+            for(std::int64_t rank = 0; rank < rank_n; ++rank) {
+                if(counts[rank] < 0 || displs[rank] < 0 || displs[rank] + counts[rank] > input_n) {
+                    throw std::length_error("hpx_collectives scatterv: counts exceed the input");
+                }
+            }
+
+            blocks.reserve(rank_n, 0);
+            for(std::int64_t rel = 0; rel < rank_n; ++rel) {
+                const std::int64_t rank = (rel + root) % rank_n;
+                blocks.append<Serialization>(
+                    input_beg + displs[rank], input_beg + displs[rank] + counts[rank]
+                );
+            }
+        }
+        else {
+            blocks = slots::wait(args, 0);
+        }
+
+        const auto children = tree.children(rank_me);
+        for(auto child = children.rbegin(); child != children.rend(); ++child) {
+            const std::int64_t first = child->first - rank_me;
+            blocks.slice(first, first + tree.subtree_n(child->first)).post(
+                args, comm.global_of_relative(child->first, root), 0
+            );
+        }
+
+        blocks.unpack<Serialization, value_type>(0, out_beg);
+
+        if constexpr(is_blocking<BlockingPolicy>()) {
+            comm.barrier();
+        }
+    }
+
+    // splits [input_beg, input_end) with the distribution policy
+    //
+    template<typename InputIterator, typename OutputIterator, typename DistributionPolicy = balanced_distribution>
+    void operator()(InputIterator input_beg, InputIterator input_end, OutputIterator out_beg, const DistributionPolicy & policy = DistributionPolicy{}) {
+        std::vector<std::int64_t> counts{};
+        if(comm.rank_me() == root) {
+            counts = policy.counts(static_cast<std::int64_t>(input_end - input_beg), comm.rank_n());
+        }
+
+        (*this)(input_beg, input_end, counts, displacements(counts), out_beg);
+    }
+
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,187 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_SCHEDULE_HPP__
+#define __HPX_COLLECTIVES_SCHEDULE_HPP__
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <numeric>
+#include <algorithm>
+
+namespace hpx { namespace utils { namespace collectives {
+
+// tree schedules over n ranks numbered relative to the root; the radix
+// is a template parameter, so the digit arithmetic below divides by a
+// constant and radix 2 compiles to shifts and masks
+//
+// both schedules answer the same questions:
+//
+//     parent(rel, slot)  parent of rel, and the slot it receives rel in
+//     children(rel)      children of rel with their slots, in buffer order
+//     subtree_n(rel)     ranks in the subtree of rel
+//     order(rel)         the subtree of rel in buffer order: rel, then the
+//                        subtree of every child, children in order
+//     slot_n()           distinct slots a parent receives children in
+//
+
+// MPICH style k-nomial tree, valid for any n; the parent of rel clears
+// its lowest nonzero base K digit, so a subtree covers a contiguous
+// range of relative ranks. children are nearest first, each round r
+// adds K - 1 children K^r apart
+//
+template<std::int64_t K>
+class knomial_schedule {
+
+    static_assert(K >= 2, "a k-nomial tree needs a radix of at least 2");
+
+    std::int64_t n;
+
+    // K^r for the lowest nonzero base K digit r of rel > 0
+    //
+    static constexpr std::int64_t lowest_digit_power(const std::int64_t rel) {
+        std::int64_t power = 1;
+        while(((rel / power) % K) == 0) { power *= K; }
+        return power;
+    }
+
+public:
+    static constexpr std::int64_t radix = K;
+
+    explicit constexpr knomial_schedule(const std::int64_t n_) : n(n_) {
+    }
+
+    constexpr std::int64_t size() const { return n; }
+
+    constexpr std::int64_t rounds() const {
+        std::int64_t round = 0;
+        for(std::int64_t power = 1; power < n; power *= K) { ++round; }
+        return round;
+    }
+
+    constexpr std::int64_t slot_n() const { return std::max(rounds(), std::int64_t{1}) * (K - 1); }
+
+    // for radix 2 the slot is the round, the bit the parent waits on
+    //
+    constexpr std::int64_t parent(const std::int64_t rel, std::int64_t & slot) const {
+        std::int64_t round = 0, power = 1;
+        while(((rel / power) % K) == 0) { power *= K; ++round; }
+        const std::int64_t digit = (rel / power) % K;
+        slot = (round * (K - 1)) + (digit - 1);
+        return rel - (digit * power);
+    }
+
+    std::vector< std::pair<std::int64_t, std::int64_t> > children(const std::int64_t rel) const {
+        std::vector< std::pair<std::int64_t, std::int64_t> > kids{};
+        std::int64_t round = 0;
+        for(std::int64_t power = 1; power < n && (rel % (power * K)) == 0; power *= K, ++round) {
+            for(std::int64_t digit = 1; digit < K; ++digit) {
+                const std::int64_t child = rel + (digit * power);
+                if(child >= n) { break; }
+                kids.emplace_back(child, (round * (K - 1)) + (digit - 1));
+            }
+        }
+        return kids;
+    }
+
+    // a subtree is one range of relative ranks, so every rank is in the
+    // same run (see rank_runs)
+    //
+    constexpr std::int64_t run(const std::int64_t) const { return 0; }
+
+    constexpr std::int64_t subtree_n(const std::int64_t rel) const {
+        if(rel == 0) { return n; }
+        return std::min(lowest_digit_power(rel), n - rel);
+    }
+
+    std::vector<std::int64_t> order(const std::int64_t rel) const {
+        std::vector<std::int64_t> ranks(subtree_n(rel));
+        std::iota(ranks.begin(), ranks.end(), rel);
+        return ranks;
+    }
+};
+
+// complete k-ary tree in heap layout: the children of rel are
+// K rel + 1 .. K rel + K. subtrees are not contiguous in rank, so buffer
+// order is the preorder of the subtree
+//
+template<std::int64_t K>
+class kary_schedule {
+
+    static_assert(K >= 2, "a k-ary tree needs a radix of at least 2");
+
+    std::int64_t n;
+
+public:
+    static constexpr std::int64_t radix = K;
+
+    explicit constexpr kary_schedule(const std::int64_t n_) : n(n_) {
+    }
+
+    constexpr std::int64_t size() const { return n; }
+
+    constexpr std::int64_t slot_n() const { return K; }
+
+    constexpr std::int64_t parent(const std::int64_t rel, std::int64_t & slot) const {
+        slot = (rel - 1) % K;
+        return (rel - 1) / K;
+    }
+
+    std::vector< std::pair<std::int64_t, std::int64_t> > children(const std::int64_t rel) const {
+        std::vector< std::pair<std::int64_t, std::int64_t> > kids{};
+        for(std::int64_t slot = 0; slot < K; ++slot) {
+            const std::int64_t child = (K * rel) + 1 + slot;
+            if(child >= n) { break; }
+            kids.emplace_back(child, slot);
+        }
+        return kids;
+    }
+
+    // a subtree's levels are contiguous ranges of rank, so the run of rel
+    // (see rank_runs) is its depth
+    //
+    constexpr std::int64_t run(std::int64_t rel) const {
+        std::int64_t depth = 0;
+        for(; rel > 0; rel = (rel - 1) / K) { ++depth; }
+        return depth;
+    }
+
+    // a subtree's levels are contiguous ranges of rank
+    //
+    constexpr std::int64_t subtree_n(const std::int64_t rel) const {
+        std::int64_t count = 0;
+        for(std::int64_t first = rel, last = rel; first < n; first = (K * first) + 1, last = (K * last) + K) {
+            count += std::min(last, n - 1) - first + 1;
+        }
+        return count;
+    }
+
+    std::vector<std::int64_t> order(const std::int64_t rel) const {
+        std::vector<std::int64_t> ranks{};
+        ranks.reserve(subtree_n(rel));
+
+        std::vector<std::int64_t> pending{rel};
+        while(!pending.empty()) {
+            const std::int64_t next = pending.back();
+            pending.pop_back();
+            ranks.push_back(next);
+
+            for(std::int64_t slot = K; slot-- > 0;) {
+                const std::int64_t child = (K * next) + 1 + slot;
+                if(child < n) { pending.push_back(child); }
+            }
+        }
+
+        return ranks;
+    }
+};
+
+using binomial_schedule = knomial_schedule<2>;
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
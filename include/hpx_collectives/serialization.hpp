@@ -4,6 +4,13 @@
 
 #include <type_traits>
 #include <string>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <cstring>
+#include <iterator>
+#include <algorithm>
 
 #include "serialization_hpx.hpp"
 #include "serialization_boost.hpp"
@@ -16,6 +23,157 @@ namespace hpx { namespace utils { namespace collectives { namespace serializatio
     using backend = boost;
 #endif
 
+template<typename Serialization, typename T>
+std::string pack(const T & value) {
+    typename Serialization::value_type value_buffer{};
+    typename Serialization::serializer value_oa{value_buffer};
+    value_oa << value;
+    return Serialization::get_buffer(value_buffer);
+}
+
+template<typename Serialization, typename T>
+T unpack(const std::string & data) {
+    T value{};
+    typename Serialization::value_type value_buffer{data};
+    typename Serialization::deserializer value_ia{value_buffer};
+    value_ia >> value;
+    return value;
+}
+
+// a range as its element count followed by the elements, so ranges of
+// any length can be concatenated in order on the receiving side
+//
+template<typename Serialization, typename InputIterator>
+std::string pack_range(InputIterator input_beg, InputIterator input_end) {
+    typename Serialization::value_type value_buffer{};
+    typename Serialization::serializer value_oa{value_buffer};
+
+    const std::int64_t count = static_cast<std::int64_t>(std::distance(input_beg, input_end));
+    value_oa << count;
+    for(auto itr = input_beg; itr != input_end; ++itr) {
+        value_oa << (*itr);
+    }
+
+    return Serialization::get_buffer(value_buffer);
+}
+
+// writes the elements of a pack_range buffer to out_beg and returns the
+// iterator past the last one written
+//
+template<typename Serialization, typename ValueType, typename OutputIterator>
+OutputIterator unpack_range(const std::string & data, OutputIterator out_beg) {
+    typename Serialization::value_type value_buffer{data};
+    typename Serialization::deserializer value_ia{value_buffer};
+
+    std::int64_t count = 0;
+    value_ia >> count;
+    for(std::int64_t i = 0; i < count; ++i, ++out_beg) {
+        ValueType value{};
+        value_ia >> value;
+        *out_beg = std::move(value);
+    }
+
+    return out_beg;
+}
+
+// count elements from input_beg; trivially copyable elements as their
+// raw bytes, anything else in the pack_range format. both ends must agree
+// on the element type
+//
+template<typename Serialization, typename InputIterator>
+std::string pack_values(InputIterator input_beg, const std::int64_t count) {
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    if constexpr(std::is_trivially_copyable<value_type>::value) {
+        std::string data(count * sizeof(value_type), '\0');
+        for(std::int64_t i = 0; i < count; ++i, ++input_beg) {
+            const value_type value = *input_beg;
+            std::memcpy(&data[i * sizeof(value_type)], &value, sizeof(value_type));
+        }
+        return data;
+    }
+    else {
+        auto input_end = input_beg;
+        std::advance(input_end, count);
+        return pack_range<Serialization>(input_beg, input_end);
+    }
+}
+
+// writes the elements of a pack_values buffer to out_beg, sets count to
+// their number and returns the iterator past the last one written
+//
+template<typename Serialization, typename ValueType, typename OutputIterator>
+OutputIterator unpack_values(const std::string & data, OutputIterator out_beg, std::int64_t & count) {
+    if constexpr(std::is_trivially_copyable<ValueType>::value) {
+        count = static_cast<std::int64_t>(data.size() / sizeof(ValueType));
+        for(std::int64_t i = 0; i < count; ++i, ++out_beg) {
+            ValueType value;
+            std::memcpy(&value, data.data() + (i * sizeof(ValueType)), sizeof(ValueType));
+            *out_beg = value;
+        }
+        return out_beg;
+    }
+    else {
+        std::vector<ValueType> values{};
+        unpack_range<Serialization, ValueType>(data, std::back_inserter(values));
+        count = static_cast<std::int64_t>(values.size());
+        return std::move(values.begin(), values.end(), out_beg);
+    }
+}
+
+// a tuple as its elements in order, so tuples of serializable types
+// travel with either backend
+//
+template<typename Serialization, typename... Ts>
+std::string pack_tuple(const std::tuple<Ts...> & value) {
+    typename Serialization::value_type value_buffer{};
+    typename Serialization::serializer value_oa{value_buffer};
+    std::apply([&value_oa](const Ts & ... element) { ((value_oa << element), ...); }, value);
+    return Serialization::get_buffer(value_buffer);
+}
+
+template<typename Serialization, typename... Ts>
+std::tuple<Ts...> unpack_tuple(const std::string & data) {
+    std::tuple<Ts...> value{};
+    typename Serialization::value_type value_buffer{data};
+    typename Serialization::deserializer value_ia{value_buffer};
+    std::apply([&value_ia](Ts & ... element) { ((value_ia >> element), ...); }, value);
+    return value;
+}
+
+// key/value pairs in columns: the count, every key, then every value;
+// keys of one type and values of another each serialize back to back
+//
+template<typename Serialization, typename KeyIterator, typename ValueIterator>
+std::string pack_columns(KeyIterator keys_beg, KeyIterator keys_end, ValueIterator values_beg) {
+    typename Serialization::value_type value_buffer{};
+    typename Serialization::serializer value_oa{value_buffer};
+
+    const std::int64_t count = static_cast<std::int64_t>(std::distance(keys_beg, keys_end));
+    value_oa << count;
+    for(auto itr = keys_beg; itr != keys_end; ++itr) {
+        value_oa << (*itr);
+    }
+    for(std::int64_t i = 0; i < count; ++i, ++values_beg) {
+        value_oa << (*values_beg);
+    }
+
+    return Serialization::get_buffer(value_buffer);
+}
+
+template<typename Serialization, typename Key, typename Value>
+void unpack_columns(const std::string & data, std::vector<Key> & keys, std::vector<Value> & values) {
+    typename Serialization::value_type value_buffer{data};
+    typename Serialization::deserializer value_ia{value_buffer};
+
+    std::int64_t count = 0;
+    value_ia >> count;
+    keys.resize(count);
+    values.resize(count);
+    for(auto & key : keys) { value_ia >> key; }
+    for(auto & value : values) { value_ia >> value; }
+}
+
 } } } } // end namespaces
 
 #endif
@@ -0,0 +1,76 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_SLOTS_HPP__
+#define __HPX_COLLECTIVES_SLOTS_HPP__
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <cstdint>
+#include <utility>
+
+#include "transport.hpp"
+#include "mailbox.hpp"
+#include "utils.hpp"
+
+REGISTER_DISTRIBUTED_OBJECT_PART(std::tuple<std::vector<std::int32_t>, std::vector<std::string>>);
+REGISTER_DISTRIBUTED_OBJECT_PART(std::tuple<std::vector<std::int32_t>, std::vector<std::vector<std::string>>>);
+
+namespace hpx { namespace utils { namespace collectives { namespace slots {
+
+// 0: one flag per slot
+// 1: one payload per slot
+//
+// for collectives where every slot, usually a round, receives at most
+// one message per call; the vectors are sized up front and never resized,
+// so a slot can be filled while another one is read
+//
+template<typename Payload>
+using mailbox_t = std::tuple< std::vector<std::int32_t>, std::vector<Payload> >;
+
+template<typename Payload>
+mailbox_t<Payload> make_mailbox(const std::int64_t slot_n) {
+    return std::make_tuple(std::vector<std::int32_t>(slot_n, 0), std::vector<Payload>(slot_n));
+}
+
+// ceil(log2 rank_n)
+//
+static inline std::int64_t rounds(const std::int64_t rank_n) {
+    std::int64_t round = 0;
+    while((std::int64_t{1} << round) < rank_n) { ++round; }
+    return round;
+}
+
+template<typename Payload>
+void post(mailbox< mailbox_t<Payload> > & args, const std::int64_t target, const std::int64_t slot, Payload && data) {
+    args.post(
+        target,
+        [](mailbox< mailbox_t<Payload> > & args_, std::int64_t slot_, Payload data_) {
+            std::get<1>(*args_)[slot_] = std::move(data_);
+            atomic_xchange( &std::get<0>(*args_)[slot_], 0, 1 );
+        }, slot, std::move(data)
+    );
+}
+
+template<typename Payload>
+Payload wait(mailbox< mailbox_t<Payload> > & args, const std::int64_t slot) {
+    while(!atomic_xchange( &std::get<0>(*args)[slot], 1, 0 )) { transport::yield(); }
+    return std::move(std::get<1>(*args)[slot]);
+}
+
+// takes the payload of slot if it has arrived, without waiting
+//
+template<typename Payload>
+bool try_wait(mailbox< mailbox_t<Payload> > & args, const std::int64_t slot, Payload & data) {
+    if(!atomic_xchange( &std::get<0>(*args)[slot], 1, 0 )) { return false; }
+    data = std::move(std::get<1>(*args)[slot]);
+    return true;
+}
+
+} /* end namespace slots */ } /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,231 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_SPARSE_VECTOR_HPP__
+#define __HPX_COLLECTIVES_SPARSE_VECTOR_HPP__
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <numeric>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "collective_traits.hpp"
+
+namespace hpx { namespace utils { namespace collectives {
+
+// a vector of dimension elements that holds only its nonzeros, as sorted
+// index and value columns, until more than threshold of its elements are
+// nonzero; then it holds every element. the representation changes on
+// its own as vectors are merged, so what goes on the wire is
+// proportional to the nonzeros for as long as that is the smaller form
+//
+// an absent element is Value{}, which must be the identity of the op the
+// vector is reduced with (0 for a sum, say)
+//
+template<typename Value>
+class sparse_vector {
+
+    std::int64_t dimension;
+    double threshold;
+    bool dense;
+    std::vector<std::int64_t> indices_;
+    std::vector<Value> values_;
+
+    void densify() {
+        std::vector<Value> all(dimension, Value{});
+        for(std::size_t k = 0; k < indices_.size(); ++k) {
+            all[indices_[k]] = std::move(values_[k]);
+        }
+        values_ = std::move(all);
+        indices_.clear();
+        indices_.shrink_to_fit();
+        dense = true;
+    }
+
+    void adapt() {
+        if(!dense && static_cast<double>(indices_.size()) > (threshold * static_cast<double>(dimension))) {
+            densify();
+        }
+    }
+
+public:
+    // the fill above which the dense form is smaller on the wire than the
+    // index and value columns
+    //
+    static constexpr double default_threshold() {
+        return static_cast<double>(sizeof(Value)) / static_cast<double>(sizeof(Value) + sizeof(std::int64_t));
+    }
+
+    sparse_vector() :
+        dimension(0), threshold(default_threshold()), dense(false), indices_(), values_() {
+    }
+
+    explicit sparse_vector(const std::int64_t dimension_, const double threshold_=default_threshold()) :
+        dimension(dimension_), threshold(threshold_), dense(false), indices_(), values_() {
+    }
+
+    // the elements at [indices_beg, indices_end), in any order; values of
+    // a repeated index are folded with op
+    //
+    template<typename IndexIterator, typename ValueIterator, typename BinaryOp = std::plus<>>
+    sparse_vector(const std::int64_t dimension_, IndexIterator indices_beg, IndexIterator indices_end, ValueIterator values_beg, BinaryOp op = BinaryOp{}, const double threshold_=default_threshold()) :
+        sparse_vector(dimension_, threshold_) {
+
+        std::vector< std::pair<std::int64_t, Value> > pairs{};
+        for(; indices_beg != indices_end; ++indices_beg, ++values_beg) {
+            const std::int64_t index = static_cast<std::int64_t>(*indices_beg);
+            if(index < 0 || index >= dimension) {
+                throw std::out_of_range("hpx_collectives sparse_vector: index outside the dimension");
+            }
+            pairs.emplace_back(index, *values_beg);
+        }
+
+        std::stable_sort(pairs.begin(), pairs.end(),
+            [](const std::pair<std::int64_t, Value> & lhs, const std::pair<std::int64_t, Value> & rhs) { return lhs.first < rhs.first; });
+
+        for(auto & pair : pairs) {
+            if(!indices_.empty() && indices_.back() == pair.first) {
+                values_.back() = op(values_.back(), std::move(pair.second));
+            }
+            else {
+                indices_.push_back(pair.first);
+                values_.push_back(std::move(pair.second));
+            }
+        }
+
+        adapt();
+    }
+
+    std::int64_t size() const { return dimension; }
+
+    bool is_dense() const { return dense; }
+
+    // stored elements: the nonzeros when sparse, every element when dense
+    //
+    std::int64_t stored() const { return static_cast<std::int64_t>(values_.size()); }
+
+    // empty when dense
+    //
+    const std::vector<std::int64_t> & indices() const { return indices_; }
+
+    const std::vector<Value> & values() const { return values_; }
+
+    // writes all dimension elements to out_beg
+    //
+    template<typename OutputIterator>
+    OutputIterator to_dense(OutputIterator out_beg) const {
+        if(dense) {
+            return std::copy(values_.begin(), values_.end(), out_beg);
+        }
+
+        std::int64_t next = 0;
+        for(std::size_t k = 0; k < indices_.size(); ++k) {
+            for(; next < indices_[k]; ++next, ++out_beg) { *out_beg = Value{}; }
+            *out_beg = values_[k];
+            ++out_beg;
+            ++next;
+        }
+        for(; next < dimension; ++next, ++out_beg) { *out_beg = Value{}; }
+        return out_beg;
+    }
+
+    // this = this op other, element-wise
+    //
+    template<typename BinaryOp>
+    void merge(const sparse_vector & other, BinaryOp & op) {
+        if(other.dimension != dimension) {
+            throw std::length_error("hpx_collectives sparse_vector: merging vectors of different dimensions");
+        }
+
+        if(dense && other.dense) {
+            // contiguous and branch free, so the compiler vectorizes it for
+            // arithmetic ops
+            //
+            Value * mine = values_.data();
+            const Value * theirs = other.values_.data();
+            for(std::int64_t i = 0; i < dimension; ++i) {
+                mine[i] = op(mine[i], theirs[i]);
+            }
+            return;
+        }
+
+        if(!dense && other.dense) {
+            densify();
+            merge(other, op);
+            return;
+        }
+
+        if(dense) {
+            for(std::size_t k = 0; k < other.indices_.size(); ++k) {
+                Value & element = values_[other.indices_[k]];
+                element = op(element, other.values_[k]);
+            }
+            return;
+        }
+
+        // both sparse: merge the sorted index columns
+        //
+        std::vector<std::int64_t> merged_indices{};
+        std::vector<Value> merged_values{};
+        merged_indices.reserve(indices_.size() + other.indices_.size());
+        merged_values.reserve(indices_.size() + other.indices_.size());
+
+        std::size_t i = 0, j = 0;
+        while(i < indices_.size() && j < other.indices_.size()) {
+            if(indices_[i] < other.indices_[j]) {
+                merged_indices.push_back(indices_[i]);
+                merged_values.push_back(std::move(values_[i++]));
+            }
+            else if(other.indices_[j] < indices_[i]) {
+                merged_indices.push_back(other.indices_[j]);
+                merged_values.push_back(other.values_[j++]);
+            }
+            else {
+                merged_indices.push_back(indices_[i]);
+                merged_values.push_back(op(std::move(values_[i++]), other.values_[j++]));
+            }
+        }
+
+        merged_indices.insert(merged_indices.end(), indices_.begin() + i, indices_.end());
+        std::move(values_.begin() + i, values_.end(), std::back_inserter(merged_values));
+        merged_indices.insert(merged_indices.end(), other.indices_.begin() + j, other.indices_.end());
+        merged_values.insert(merged_values.end(), other.values_.begin() + j, other.values_.end());
+
+        indices_ = std::move(merged_indices);
+        values_ = std::move(merged_values);
+        adapt();
+    }
+
+    template<typename Archive>
+    void serialize(Archive & ar, const unsigned int) {
+        ar & dimension & threshold & dense & indices_ & values_;
+    }
+};
+
+// the op reductions fold sparse vectors with; commutative when op is
+//
+template<typename BinaryOp>
+struct sparse_merge {
+    BinaryOp op;
+
+    template<typename Value>
+    sparse_vector<Value> operator()(sparse_vector<Value> lhs, const sparse_vector<Value> & rhs) {
+        lhs.merge(rhs, op);
+        return lhs;
+    }
+};
+
+template<typename BinaryOp>
+struct is_commutative< sparse_merge<BinaryOp> > : public is_commutative<BinaryOp> {
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
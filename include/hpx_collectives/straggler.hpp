@@ -0,0 +1,161 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_STRAGGLER_HPP__
+#define __HPX_COLLECTIVES_STRAGGLER_HPP__
+
+#include <tuple>
+#include <vector>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+
+#include "transport.hpp"
+#include "schedule.hpp"
+
+REGISTER_DISTRIBUTED_OBJECT_PART(std::tuple<std::int32_t, std::int32_t, std::vector<std::vector<double>>>);
+
+namespace hpx { namespace utils { namespace collectives {
+
+// placement of the ranks of a communicator on the positions of a
+// k-nomial tree, rebuilt from observed arrival times so that persistently
+// late ranks end up as leaves and punctual ones head the large subtrees;
+// position 0 is always the root
+//
+// every parent records, per call, how long after it was ready each child
+// arrived, and every rank records how long it waited on its own
+// children. a child's own lateness is the delay its parent saw minus the
+// time it spent waiting on its subtree. reports are exchanged, so every
+// rank rebuilds the same placement from the same table
+//
+// lateness is compared in units of tolerance seconds per call; ranks
+// within the same unit keep their positions, so noise does not move
+// punctual ranks around
+//
+template<std::int64_t K>
+class straggler_placement {
+
+    std::int64_t root;
+    double tolerance;
+    knomial_schedule<K> tree;
+    std::vector<std::int64_t> rank_at_;   // rank at every position
+    std::vector<std::int64_t> position_;  // position of every rank
+    std::vector<double> lateness_;        // smoothed seconds per call, by rank
+    std::vector<double> delay;            // this epoch, by child index
+    double waited;
+    std::int64_t calls_;
+    std::int64_t epoch_;
+
+    std::int64_t units(const double seconds) const {
+        return static_cast<std::int64_t>(seconds / tolerance);
+    }
+
+public:
+    straggler_placement(const std::int64_t rank_n, const std::int64_t root_, const double tolerance_=1e-4) :
+        root(root_),
+        tolerance(tolerance_),
+        tree(rank_n),
+        rank_at_(rank_n),
+        position_(rank_n),
+        lateness_(rank_n, 0.0),
+        delay(),
+        waited(0.0),
+        calls_(0),
+        epoch_(0) {
+        // the fixed tree to start with: positions relative to the root
+        //
+        for(std::int64_t pos = 0; pos < rank_n; ++pos) {
+            rank_at_[pos] = (pos + root) % rank_n;
+            position_[rank_at_[pos]] = pos;
+        }
+    }
+
+    const knomial_schedule<K> & schedule() const { return tree; }
+
+    std::int64_t rank_at(const std::int64_t pos) const { return rank_at_[pos]; }
+
+    std::int64_t position(const std::int64_t rank) const { return position_[rank]; }
+
+    const std::vector<double> & lateness() const { return lateness_; }
+
+    std::int64_t calls() const { return calls_; }
+
+    std::int64_t epoch() const { return epoch_; }
+
+    // one call of this rank: child i of its position arrived delays[i]
+    // seconds after it was ready, and it waited wait seconds in all
+    //
+    void observe(const std::vector<double> & delays, const double wait) {
+        if(delay.size() != delays.size()) { delay.assign(delays.size(), 0.0); }
+        for(std::size_t i = 0; i < delays.size(); ++i) { delay[i] += delays[i]; }
+        waited += wait;
+        ++calls_;
+    }
+
+    // this rank's contribution to the rebuild: the time it waited, then
+    // (child rank, delay) pairs, all summed over the epoch
+    //
+    std::vector<double> report(const std::int64_t rank_me) const {
+        std::vector<double> values{waited};
+        const auto children = tree.children(position_[rank_me]);
+        for(std::size_t i = 0; i < children.size(); ++i) {
+            values.push_back(static_cast<double>(rank_at_[children[i].first]));
+            values.push_back((i < delay.size()) ? delay[i] : 0.0);
+        }
+        return values;
+    }
+
+    // reports[r] is the report of rank r; the lateness estimate of this
+    // epoch is averaged with the previous one, so a single noisy epoch
+    // does not reshuffle the tree
+    //
+    void rebuild(const std::vector< std::vector<double> > & reports) {
+        const std::int64_t rank_n = tree.size();
+        const double per_call = 1.0 / static_cast<double>(std::max(calls_, std::int64_t{1}));
+
+        std::vector<double> late(rank_n, 0.0);
+        for(std::int64_t rank = 0; rank < rank_n; ++rank) {
+            const auto & values = reports[rank];
+            for(std::size_t i = 1; i + 1 < values.size(); i += 2) {
+                const std::int64_t child = static_cast<std::int64_t>(values[i]);
+                late[child] += values[i + 1];
+            }
+        }
+
+        for(std::int64_t rank = 0; rank < rank_n; ++rank) {
+            const double own = std::max((late[rank] - reports[rank][0]) * per_call, 0.0);
+            lateness_[rank] = (epoch_ == 0) ? own : (0.5 * (lateness_[rank] + own));
+        }
+
+        // punctual ranks take the positions heading the largest subtrees;
+        // ranks start out in the order of the positions they hold now
+        //
+        std::vector<std::int64_t> positions(rank_n - 1), ranks(rank_n - 1);
+        std::iota(positions.begin(), positions.end(), std::int64_t{1});
+        std::stable_sort(positions.begin(), positions.end(), [this](const std::int64_t a, const std::int64_t b) {
+            return tree.subtree_n(a) > tree.subtree_n(b);
+        });
+
+        std::transform(positions.begin(), positions.end(), ranks.begin(), [this](const std::int64_t pos) { return rank_at_[pos]; });
+        std::stable_sort(ranks.begin(), ranks.end(), [this](const std::int64_t a, const std::int64_t b) {
+            return units(lateness_[a]) < units(lateness_[b]);
+        });
+
+        for(std::size_t i = 0; i < ranks.size(); ++i) {
+            rank_at_[positions[i]] = ranks[i];
+            position_[ranks[i]] = positions[i];
+        }
+
+        delay.clear();
+        waited = 0.0;
+        calls_ = 0;
+        ++epoch_;
+    }
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
@@ -0,0 +1,150 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_STREAM_SINK_HPP__
+#define __HPX_COLLECTIVES_STREAM_SINK_HPP__
+
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace hpx { namespace utils { namespace collectives {
+
+// a byte sink gather_stream writes on the root; anything providing
+//
+//     void reserve(std::int64_t bytes);
+//     void write(const char * data, std::int64_t len);
+//
+// works; reserve is called once with the total before the first write,
+// and writes arrive in rank order
+//
+template<typename T, typename = void>
+struct is_stream_sink : public std::false_type {
+};
+
+template<typename T>
+struct is_stream_sink<T, std::void_t<
+    decltype(std::declval<T &>().reserve(std::int64_t{})),
+    decltype(std::declval<T &>().write(std::declval<const char *>(), std::int64_t{}))
+> > : public std::true_type {
+};
+
+// shared mapping of an output file sized on reserve; written pages are
+// handed back to the kernel, which writes them back, so the resident set
+// stays at about one chunk no matter how large the file is
+//
+class mapped_output_file {
+
+    int fd;
+    char * base;
+    std::int64_t length;
+    std::int64_t cursor;
+    std::int64_t released;
+    std::string path;
+
+    [[noreturn]] void fail(const std::string & what) const {
+        throw std::runtime_error("hpx_collectives mapped_output_file: " + what + " '" + path + "': " + std::strerror(errno));
+    }
+
+public:
+    explicit mapped_output_file(const std::string & path_) :
+        fd(-1), base(nullptr), length(0), cursor(0), released(0), path(path_) {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if(fd < 0) { fail("open"); }
+    }
+
+    mapped_output_file(const mapped_output_file &) = delete;
+    mapped_output_file & operator=(const mapped_output_file &) = delete;
+
+    ~mapped_output_file() {
+        if(base != nullptr) { ::munmap(base, length); }
+        if(fd >= 0) { ::close(fd); }
+    }
+
+    void reserve(const std::int64_t bytes) {
+        if(base != nullptr) { ::munmap(base, length); base = nullptr; }
+        length = bytes;
+        cursor = 0;
+        released = 0;
+
+        if(::ftruncate(fd, length) != 0) { fail("ftruncate"); }
+        if(length > 0) {
+            void * addr = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if(addr == MAP_FAILED) { fail("mmap"); }
+            base = static_cast<char *>(addr);
+        }
+    }
+
+    void write(const char * data, const std::int64_t len) {
+        if(cursor + len > length) {
+            throw std::length_error("hpx_collectives mapped_output_file: write past reserved size of '" + path + "'");
+        }
+
+        std::memcpy(base + cursor, data, len);
+        cursor += len;
+
+        // drop the whole pages written so far
+        //
+        const std::int64_t page = static_cast<std::int64_t>(::sysconf(_SC_PAGESIZE));
+        const std::int64_t upto = (cursor / page) * page;
+        if(upto > released) {
+            ::madvise(base + released, upto - released, MADV_DONTNEED);
+            released = upto;
+        }
+    }
+};
+
+// write(2) based sink, for outputs that cannot be mapped
+//
+class file_writer {
+
+    int fd;
+    std::string path;
+
+public:
+    explicit file_writer(const std::string & path_) :
+        fd(-1), path(path_) {
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(fd < 0) {
+            throw std::runtime_error("hpx_collectives file_writer: open '" + path + "': " + std::strerror(errno));
+        }
+    }
+
+    file_writer(const file_writer &) = delete;
+    file_writer & operator=(const file_writer &) = delete;
+
+    ~file_writer() {
+        if(fd >= 0) { ::close(fd); }
+    }
+
+    void reserve(const std::int64_t) {
+    }
+
+    void write(const char * data, std::int64_t len) {
+        while(len > 0) {
+            const ssize_t put = ::write(fd, data, len);
+            if(put < 0 && errno == EINTR) { continue; }
+            if(put < 0) {
+                throw std::runtime_error("hpx_collectives file_writer: write '" + path + "': " + std::strerror(errno));
+            }
+            data += put;
+            len -= put;
+        }
+    }
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
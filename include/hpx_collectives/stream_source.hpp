@@ -0,0 +1,141 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_STREAM_SOURCE_HPP__
+#define __HPX_COLLECTIVES_STREAM_SOURCE_HPP__
+
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace hpx { namespace utils { namespace collectives {
+
+// a byte source scatter_stream reads on the root; anything providing
+//
+//     std::int64_t size() const;
+//     void read(std::int64_t offset, char * dst, std::int64_t len);
+//
+// works, reads arrive in increasing offset order and are never larger
+// than the stream's chunk size
+//
+
+// read only mapping of a whole file; pages are handed back to the kernel
+// once read, so the resident set stays at about one chunk no matter how
+// large the file is
+//
+class mapped_file {
+
+    int fd;
+    char * base;
+    std::int64_t length;
+    std::int64_t released;
+
+    [[noreturn]] static void fail(const std::string & what, const std::string & path) {
+        throw std::runtime_error("hpx_collectives mapped_file: " + what + " '" + path + "': " + std::strerror(errno));
+    }
+
+public:
+    explicit mapped_file(const std::string & path) :
+        fd(-1), base(nullptr), length(0), released(0) {
+        fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) { fail("open", path); }
+
+        struct stat st{};
+        if(::fstat(fd, &st) != 0) { ::close(fd); fail("fstat", path); }
+        length = static_cast<std::int64_t>(st.st_size);
+
+        if(length > 0) {
+            void * addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(addr == MAP_FAILED) { ::close(fd); fail("mmap", path); }
+            base = static_cast<char *>(addr);
+            ::madvise(base, length, MADV_SEQUENTIAL);
+        }
+    }
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file & operator=(const mapped_file &) = delete;
+
+    ~mapped_file() {
+        if(base != nullptr) { ::munmap(base, length); }
+        if(fd >= 0) { ::close(fd); }
+    }
+
+    std::int64_t size() const { return length; }
+
+    const char * data() const { return base; }
+
+    void read(const std::int64_t offset, char * dst, const std::int64_t len) {
+        std::memcpy(dst, base + offset, len);
+
+        // drop the whole pages before the end of this read
+        //
+        const std::int64_t page = static_cast<std::int64_t>(::sysconf(_SC_PAGESIZE));
+        const std::int64_t upto = ((offset + len) / page) * page;
+        if(upto > released) {
+            ::madvise(base + released, upto - released, MADV_DONTNEED);
+            released = upto;
+        }
+    }
+};
+
+// pread based reader for files that cannot be mapped (pipes excluded);
+// holds no buffer of its own
+//
+class file_reader {
+
+    int fd;
+    std::int64_t length;
+    std::string path;
+
+public:
+    explicit file_reader(const std::string & path_) :
+        fd(-1), length(0), path(path_) {
+        fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) {
+            throw std::runtime_error("hpx_collectives file_reader: open '" + path + "': " + std::strerror(errno));
+        }
+
+        struct stat st{};
+        if(::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("hpx_collectives file_reader: fstat '" + path + "': " + std::strerror(errno));
+        }
+        length = static_cast<std::int64_t>(st.st_size);
+    }
+
+    file_reader(const file_reader &) = delete;
+    file_reader & operator=(const file_reader &) = delete;
+
+    ~file_reader() {
+        if(fd >= 0) { ::close(fd); }
+    }
+
+    std::int64_t size() const { return length; }
+
+    void read(std::int64_t offset, char * dst, std::int64_t len) {
+        while(len > 0) {
+            const ssize_t got = ::pread(fd, dst, len, offset);
+            if(got < 0 && errno == EINTR) { continue; }
+            if(got <= 0) {
+                throw std::runtime_error("hpx_collectives file_reader: pread '" + path + "': " + std::strerror(got < 0 ? errno : EIO));
+            }
+            offset += got;
+            dst += got;
+            len -= got;
+        }
+    }
+};
+
+} /* end namespace collectives */ } /* end namespace utils */ } /* end namespace hpx */
+
+#endif
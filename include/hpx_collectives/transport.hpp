@@ -0,0 +1,74 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_TRANSPORT__
+#define __HPX_COLLECTIVES_TRANSPORT__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "transport_priority.hpp"
+#include "transport_hpx.hpp"
+#include "transport_simulator.hpp"
+
+namespace hpx { namespace utils { namespace collectives { namespace transport {
+
+#ifdef HPX_COLLECTIVES_SIMULATOR
+    using backend = simulator;
+#else
+    using backend = hpx;
+#endif
+
+// mailbox and active message interface used by the collectives; the
+// backend is selected at compile time the same way the serializer is
+//
+template<typename T>
+using distributed_object = typename backend::template distributed_object<T>;
+
+using barrier = typename backend::barrier;
+
+template<typename F, typename... Args>
+static inline void async(const std::int64_t target, F && f, Args &&... args) {
+    backend::async(handler_priority::normal, target, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+// runs f on target at the given priority; collectives post with the
+// priority of their communicator
+//
+template<typename F, typename... Args>
+static inline void async(const handler_priority priority, const std::int64_t target, F && f, Args &&... args) {
+    backend::async(priority, target, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+static inline std::int64_t rank_me() {
+    return backend::rank_me();
+}
+
+static inline std::int64_t rank_n() {
+    return backend::rank_n();
+}
+
+static inline void yield() {
+    backend::yield();
+}
+
+static inline std::string hostname() {
+    return backend::hostname();
+}
+
+// node_of_rank[r] is the node id of locality r, e.g. node_map::node_ids();
+// afterwards every collective moves large payloads between co-located
+// localities through shared memory
+//
+static inline void enable_shared_memory(const std::vector<std::int64_t> & node_of_rank) {
+    backend::enable_shared_memory(node_of_rank);
+}
+
+} } } } // end namespaces
+
+#endif
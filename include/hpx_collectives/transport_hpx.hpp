@@ -0,0 +1,176 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_TRANSPORT_HPX__
+#define __HPX_COLLECTIVES_TRANSPORT_HPX__
+
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include <unistd.h>
+
+#include "transport_shm.hpp"
+#include "transport_priority.hpp"
+
+#ifndef HPX_COLLECTIVES_SIMULATOR
+    #include <hpx/include/async.hpp>
+    #include <hpx/include/threads.hpp>
+    #include <hpx/lcos/barrier.hpp>
+    #include <hpx/lcos/distributed_object.hpp>
+#endif
+
+namespace hpx { namespace utils { namespace collectives { namespace transport {
+
+#ifndef HPX_COLLECTIVES_SIMULATOR
+
+struct hpx {
+
+    // registered on a subset of localities when given the members of a
+    // communicator, on all of them otherwise
+    //
+    template<typename T>
+    class distributed_object : public ::hpx::lcos::distributed_object<T> {
+
+        using base_type = ::hpx::lcos::distributed_object<T>;
+
+    public:
+        using value_type = T;
+
+        distributed_object(const std::string & name, T init) :
+            base_type(name, std::move(init)) {
+        }
+
+        distributed_object(const std::string & name, T init, const std::vector<std::int64_t> & members) :
+            base_type(name, std::move(init), ::hpx::lcos::construction_type::Meta_Object,
+                std::vector<std::size_t>(members.begin(), members.end())) {
+        }
+    };
+
+    using barrier = ::hpx::lcos::barrier;
+
+private:
+
+    // set up by enable_shared_memory
+    //
+    static std::unique_ptr<shm::domain> & shared_memory_domain() {
+        static std::unique_ptr<shm::domain> dom{};
+        return dom;
+    }
+
+    static shm::domain & shared_memory() {
+        return *shared_memory_domain();
+    }
+
+    // pid and start time of this process; locality 0's names the job
+    //
+    static const std::string & job_token() {
+        static const std::string token = std::to_string(::getpid()) + "_" +
+            std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+        return token;
+    }
+
+    // HPX_COLLECTIVES_SHM_PREFIX if set, otherwise one per user and job,
+    // so jobs sharing a host never open each other's rings
+    //
+    static std::string segment_prefix() {
+        const char * prefix = std::getenv("HPX_COLLECTIVES_SHM_PREFIX");
+        if(prefix != nullptr) { return std::string{prefix}; }
+
+        const std::string token = ::hpx::async(launch_policy(handler_priority::normal), std::int64_t{0},
+            []() { return job_token(); }).get();
+        return "/hpx_collectives_" + std::to_string(::getuid()) + "_" + token + "_";
+    }
+
+    static std::shared_ptr< const std::vector<std::int64_t> > & node_table() {
+        static std::shared_ptr< const std::vector<std::int64_t> > table{};
+        return table;
+    }
+
+    static bool co_located(const std::int64_t target) {
+        const auto & table = node_table();
+        const std::int64_t me = rank_me();
+        return table && target != me && (*table)[target] == (*table)[me];
+    }
+
+    static ::hpx::launch::async_policy launch_policy(const handler_priority priority) {
+        return ::hpx::launch::async_policy((priority == handler_priority::high) ?
+            ::hpx::threads::thread_priority_high : ::hpx::threads::thread_priority_normal);
+    }
+
+public:
+
+    // node_of_rank[r] is the node id of locality r (see node_map::node_ids);
+    // once set, string payloads to co-located localities go through a
+    // shared memory ring instead of a parcel. the segment prefix is taken
+    // from locality 0 the first time
+    //
+    static void enable_shared_memory(const std::vector<std::int64_t> & node_of_rank) {
+        if(!shared_memory_domain()) {
+            shared_memory_domain() = std::make_unique<shm::domain>(segment_prefix());
+        }
+        node_table() = std::make_shared< const std::vector<std::int64_t> >(node_of_rank);
+    }
+
+    template<typename F, typename... Args>
+    static void async(const handler_priority priority, const std::int64_t target, F && f, Args &&... args) {
+        if(!co_located(target)) {
+            ::hpx::async(launch_policy(priority), target, std::forward<F>(f), std::forward<Args>(args)...);
+            return;
+        }
+
+        // the parcel carries ring positions; the receiving locality
+        // copies the payloads out and runs the original action
+        //
+        ::hpx::async(launch_policy(priority), target,
+            [](std::decay_t<F> fn, shm::staged_t<Args>... staged) {
+                fn(shm::unstage(shared_memory(), rank_me(), staged)...);
+            },
+            std::decay_t<F>(std::forward<F>(f)),
+            shm::stage(shared_memory(), rank_me(), target, std::forward<Args>(args), []() { ::hpx::this_thread::yield(); })...
+        );
+    }
+
+    static std::int64_t rank_me() {
+        return static_cast<std::int64_t>(::hpx::get_locality_id());
+    }
+
+    static std::int64_t rank_n() {
+        return static_cast<std::int64_t>(::hpx::find_all_localities().size());
+    }
+
+    static void yield() {
+        ::hpx::this_thread::yield();
+    }
+
+    static std::string hostname() {
+        char name[256] = {0};
+        ::gethostname(name, sizeof(name) - 1);
+        return std::string{name};
+    }
+};
+
+#else
+
+struct hpx {};
+
+#endif
+
+template<typename Tag>
+struct is_hpx : public std::false_type {
+};
+
+template<>
+struct is_hpx<::hpx::utils::collectives::transport::hpx> : public std::true_type {
+};
+
+} } } } // end namespaces
+
+#endif
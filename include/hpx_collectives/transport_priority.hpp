@@ -0,0 +1,21 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_TRANSPORT_PRIORITY__
+#define __HPX_COLLECTIVES_TRANSPORT_PRIORITY__
+
+namespace hpx { namespace utils { namespace collectives { namespace transport {
+
+// the priority of the thread a remote action runs on at its target;
+// mailbox handlers only store a payload, flip a flag and possibly
+// forward, so running them high keeps a tree moving while the
+// locality is saturated with long compute tasks
+//
+enum class handler_priority { normal, high };
+
+} } } } // end namespaces
+
+#endif
@@ -0,0 +1,386 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_TRANSPORT_SHM__
+#define __HPX_COLLECTIVES_TRANSPORT_SHM__
+
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace hpx { namespace utils { namespace collectives { namespace transport { namespace shm {
+
+// POSIX shared memory ring carrying payloads from one locality to one
+// co-located locality; the sender copies a payload in once and ships
+// only its position through the regular active message
+//
+// records are 16 byte aligned and never wrap, a padding record fills
+// the end of the ring instead; receivers may consume records out of
+// order, the head only moves past a run of consumed records
+//
+class ring {
+
+    struct header {
+        std::atomic<std::uint64_t> head;
+        std::atomic<std::uint64_t> tail;
+        std::uint64_t capacity;
+        std::uint64_t reserved;
+    };
+
+    struct record {
+        std::atomic<std::uint64_t> state;
+        std::uint64_t length;
+    };
+
+    enum : std::uint64_t { empty = 0, full = 1, consumed = 2, padding = 3 };
+
+    std::string name;
+    bool owner;
+    std::size_t mapped_size;
+    header * hdr;
+    char * data;
+    std::mutex produce_mtx, consume_mtx;
+
+    static std::uint64_t record_size(const std::uint64_t length) {
+        return sizeof(record) + ((length + 15) & ~std::uint64_t{15});
+    }
+
+    record * at(const std::uint64_t position) const {
+        return reinterpret_cast<record *>(data + (position % hdr->capacity));
+    }
+
+    [[noreturn]] static void fail(const std::string & what, const std::string & name_) {
+        throw std::runtime_error("hpx_collectives shm: " + what + " '" + name_ + "': " + std::strerror(errno));
+    }
+
+public:
+    // the sending side creates the segment, failing if it exists, the
+    // receiving side opens it once the first position for it arrives
+    //
+    ring(const std::string & name_, const std::uint64_t capacity, const bool create) :
+        name(name_), owner(create), mapped_size(0), hdr(nullptr), data(nullptr) {
+
+        // a segment that already exists belongs to another job with the
+        // same prefix, whose live ring must not be truncated
+        //
+        const int fd = create ? ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600) :
+            ::shm_open(name.c_str(), O_RDWR, 0600);
+
+        if(fd < 0) { fail("shm_open", name); }
+
+        if(create) {
+            mapped_size = sizeof(header) + ((capacity + 15) & ~std::uint64_t{15});
+            if(::ftruncate(fd, static_cast<off_t>(mapped_size)) != 0) { ::close(fd); fail("ftruncate", name); }
+        }
+        else {
+            struct stat st{};
+            if(::fstat(fd, &st) != 0) { ::close(fd); fail("fstat", name); }
+            mapped_size = static_cast<std::size_t>(st.st_size);
+        }
+
+        void * base = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if(base == MAP_FAILED) { fail("mmap", name); }
+
+        hdr = static_cast<header *>(base);
+        data = static_cast<char *>(base) + sizeof(header);
+
+        if(create) {
+            hdr->capacity = mapped_size - sizeof(header);
+            hdr->head.store(0);
+            hdr->tail.store(0);
+        }
+    }
+
+    ring(const ring &) = delete;
+    ring & operator=(const ring &) = delete;
+
+    ~ring() {
+        ::munmap(static_cast<void *>(hdr), mapped_size);
+        if(owner) { ::shm_unlink(name.c_str()); }
+    }
+
+    std::uint64_t capacity() const { return hdr->capacity; }
+
+    // copies length bytes into the ring, waiting (through yield) for
+    // the receiver to free space; returns the record's position
+    //
+    template<typename Yield>
+    std::uint64_t write(const char * payload, const std::uint64_t length, Yield && yield) {
+        const std::uint64_t need = record_size(length);
+        if(need > hdr->capacity) {
+            throw std::length_error("hpx_collectives shm: payload larger than ring '" + name + "'");
+        }
+
+        std::lock_guard<std::mutex> lock(produce_mtx);
+
+        std::uint64_t tail = hdr->tail.load(std::memory_order_relaxed);
+        const std::uint64_t offset = tail % hdr->capacity;
+        const std::uint64_t pad = ((hdr->capacity - offset) < need) ? (hdr->capacity - offset) : 0;
+
+        while(((tail + pad + need) - hdr->head.load(std::memory_order_acquire)) > hdr->capacity) { yield(); }
+
+        if(pad > 0) {
+            record * rec = at(tail);
+            rec->length = pad - sizeof(record);
+            rec->state.store(padding, std::memory_order_release);
+            tail += pad;
+        }
+
+        record * rec = at(tail);
+        rec->length = length;
+        std::memcpy(reinterpret_cast<char *>(rec) + sizeof(record), payload, length);
+        rec->state.store(full, std::memory_order_release);
+
+        hdr->tail.store(tail + need, std::memory_order_release);
+        return tail;
+    }
+
+    // copies the record at position out of the ring and releases it
+    //
+    std::string read(const std::uint64_t position) {
+        record * rec = at(position);
+        std::string payload(reinterpret_cast<const char *>(rec) + sizeof(record), rec->length);
+        rec->state.store(consumed, std::memory_order_release);
+
+        std::lock_guard<std::mutex> lock(consume_mtx);
+
+        std::uint64_t head = hdr->head.load(std::memory_order_relaxed);
+        const std::uint64_t tail = hdr->tail.load(std::memory_order_acquire);
+        while(head < tail) {
+            record * next = at(head);
+            const std::uint64_t state = next->state.load(std::memory_order_acquire);
+            if(state != consumed && state != padding) { break; }
+            next->state.store(empty, std::memory_order_relaxed);
+            head += record_size(next->length);
+        }
+
+        hdr->head.store(head, std::memory_order_release);
+        return payload;
+    }
+};
+
+// a payload that either travels inline with the active message or sits
+// in the sender's ring to the receiver
+//
+struct block {
+    std::int64_t source = -1;
+    std::uint64_t position = 0;
+    std::string inline_data{};
+
+    template<typename Archive>
+    void serialize(Archive & ar, const unsigned int) {
+        ar & source & position & inline_data;
+    }
+};
+
+// every ring this process sends on or receives from; segment names are
+// prefix + sender + "_" + receiver
+//
+class domain {
+
+    std::string prefix;
+    std::uint64_t capacity;
+    std::uint64_t threshold;
+    std::mutex mtx;
+    std::map< std::pair<std::int64_t, std::int64_t>, std::shared_ptr<ring> > rings;
+
+    std::shared_ptr<ring> get(const std::int64_t source, const std::int64_t target, const bool create) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto itr = rings.find({source, target});
+        if(itr == rings.end()) {
+            const std::string name = prefix + std::to_string(source) + "_" + std::to_string(target);
+            itr = rings.emplace(std::make_pair(source, target), std::make_shared<ring>(name, capacity, create)).first;
+        }
+        return itr->second;
+    }
+
+public:
+    domain(const std::string & prefix_, const std::uint64_t capacity_=std::uint64_t{1} << 23, const std::uint64_t threshold_=4096) :
+        prefix(prefix_), capacity(capacity_), threshold(threshold_) {
+    }
+
+    // most bytes one message may hold in a ring; its records are only
+    // released after delivery, so a message must never need the whole
+    // ring, and a quarter leaves room for others in flight
+    //
+    std::uint64_t limit() const {
+        return capacity / 4;
+    }
+
+    // payloads below the threshold are cheaper inline
+    //
+    bool eligible(const std::uint64_t length) const {
+        return length >= threshold && length <= limit();
+    }
+
+    // writes length bytes straight into the ring, or copies them inline
+    // when they are not eligible
+    //
+    template<typename Yield>
+    block stage(const std::int64_t source, const std::int64_t target, const char * payload, const std::uint64_t length, Yield && yield) {
+        block blk{};
+        if(eligible(length)) {
+            blk.source = source;
+            blk.position = get(source, target, true)->write(payload, length, std::forward<Yield>(yield));
+        }
+        else {
+            blk.inline_data.assign(payload, length);
+        }
+        return blk;
+    }
+
+    template<typename Yield>
+    block stage(const std::int64_t source, const std::int64_t target, std::string && payload, Yield && yield) {
+        if(eligible(payload.size())) {
+            return stage(source, target, payload.data(), payload.size(), std::forward<Yield>(yield));
+        }
+
+        block blk{};
+        blk.inline_data = std::move(payload);
+        return blk;
+    }
+
+    std::string unstage(const std::int64_t target, block && blk) {
+        if(blk.source < 0) { return std::move(blk.inline_data); }
+        return get(blk.source, target, false)->read(blk.position);
+    }
+};
+
+// which arguments of an active message are staged: strings and vectors
+// of strings, the payload types every mailbox uses
+//
+template<typename T>
+struct staged {
+    using type = T;
+};
+
+template<>
+struct staged<std::string> {
+    using type = block;
+};
+
+template<>
+struct staged< std::vector<std::string> > {
+    using type = std::vector<block>;
+};
+
+template<typename T>
+using staged_t = typename staged< std::decay_t<T> >::type;
+
+template<typename T>
+struct unstaged {
+    using type = T;
+};
+
+template<>
+struct unstaged<block> {
+    using type = std::string;
+};
+
+template<>
+struct unstaged< std::vector<block> > {
+    using type = std::vector<std::string>;
+};
+
+template<typename T>
+using unstaged_t = typename unstaged< std::decay_t<T> >::type;
+
+template<typename A, typename Yield>
+static inline staged_t<A> stage(domain & dom, const std::int64_t source, const std::int64_t target, A && a, Yield && yield) {
+    using arg_t = std::decay_t<A>;
+    constexpr bool movable = !std::is_lvalue_reference<A>::value && !std::is_const<std::remove_reference_t<A>>::value;
+
+    // payloads are written into the ring from the caller's buffer; only
+    // inline ones are copied, and moved instead when a is an rvalue
+    //
+    if constexpr(std::is_same<arg_t, std::string>::value) {
+        if constexpr(movable) {
+            return dom.stage(source, target, std::move(a), yield);
+        }
+        else {
+            return dom.stage(source, target, a.data(), a.size(), yield);
+        }
+    }
+    else if constexpr(std::is_same<arg_t, std::vector<std::string>>::value) {
+        std::vector<block> blocks{};
+        blocks.reserve(a.size());
+
+        std::uint64_t staged_bytes = 0;
+        for(auto & s : a) {
+            if(dom.eligible(s.size()) && (staged_bytes + s.size()) <= dom.limit()) {
+                blocks.push_back(dom.stage(source, target, s.data(), s.size(), yield));
+                staged_bytes += s.size();
+            }
+            else {
+                blocks.emplace_back();
+                if constexpr(movable) { blocks.back().inline_data = std::move(s); }
+                else { blocks.back().inline_data = s; }
+            }
+        }
+
+        return blocks;
+    }
+    else {
+        return arg_t(std::forward<A>(a));
+    }
+}
+
+// the staged form of a payload that still travels inline, for
+// messages between localities that do not share a host
+//
+template<typename A>
+static inline staged_t<A> carry(A && a) {
+    using arg_t = std::decay_t<A>;
+    if constexpr(std::is_same<arg_t, std::string>::value) {
+        block blk{};
+        blk.inline_data = std::string(std::forward<A>(a));
+        return blk;
+    }
+    else if constexpr(std::is_same<arg_t, std::vector<std::string>>::value) {
+        std::vector<block> blocks(a.size());
+        for(std::size_t i = 0; i < a.size(); ++i) { blocks[i].inline_data = std::string(a[i]); }
+        return blocks;
+    }
+    else {
+        return arg_t(std::forward<A>(a));
+    }
+}
+
+static inline std::string unstage(domain & dom, const std::int64_t target, block & blk) {
+    return dom.unstage(target, std::move(blk));
+}
+
+static inline std::vector<std::string> unstage(domain & dom, const std::int64_t target, std::vector<block> & blks) {
+    std::vector<std::string> payloads{};
+    payloads.reserve(blks.size());
+    for(auto & blk : blks) { payloads.push_back(dom.unstage(target, std::move(blk))); }
+    return payloads;
+}
+
+template<typename A>
+static inline A & unstage(domain &, const std::int64_t, A & a) {
+    return a;
+}
+
+} } } } } // end namespaces
+
+#endif
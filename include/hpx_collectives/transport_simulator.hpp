@@ -0,0 +1,719 @@
+//  Copyright (c) 2020 Christopher Taylor
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+#ifndef __HPX_COLLECTIVES_TRANSPORT_SIMULATOR__
+#define __HPX_COLLECTIVES_TRANSPORT_SIMULATOR__
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <unistd.h>
+
+#include "transport_shm.hpp"
+#include "transport_priority.hpp"
+
+#ifdef HPX_COLLECTIVES_SIMULATOR
+    #ifndef REGISTER_DISTRIBUTED_OBJECT_PART
+        #define REGISTER_DISTRIBUTED_OBJECT_PART(...)
+    #endif
+#endif
+
+namespace hpx { namespace utils { namespace collectives { namespace transport {
+
+#ifdef HPX_COLLECTIVES_SIMULATOR
+
+// in-process stand-in for the HPX runtime; every virtual locality is a
+// std::thread running the user function, remote actions are executed by
+// a pool of delivery threads against the target locality's copy of the
+// distributed_object
+//
+// time is modelled with LogGP (all values in microseconds); each virtual
+// locality carries a clock that is advanced by sends, deliveries and
+// barriers, so algorithm cost can be compared without real hardware
+//
+// delivery threads take high priority messages before normal ones, the
+// way HPX schedules high priority threads ahead of queued work
+//
+struct simulator {
+
+    struct config {
+        std::int64_t localities = 1;
+        double latency = 0.0;         // L
+        double overhead = 0.0;        // o
+        double gap = 0.0;             // g
+        double gap_per_byte = 0.0;    // G
+        bool inject_delay = false;    // also sleep for L + (k-1)G of wall-clock time
+        std::int64_t delivery_threads = 0; // 0 == std::thread::hardware_concurrency()
+        double timeout = 0.0;         // wall-clock seconds before run() gives up, 0 == never
+        std::int64_t localities_per_node = 1; // consecutive ranks reported as sharing a host
+        bool shared_memory = false;   // co-located localities exchange payloads through shm rings
+        std::int64_t shm_threshold = 4096;              // smallest payload staged in a ring, bytes
+        std::int64_t shm_ring_size = std::int64_t{1} << 23; // bytes per locality pair
+        double shm_latency = 0.0;     // L between co-located localities when shared_memory is on
+        double shm_gap_per_byte = 0.0; // G between co-located localities when shared_memory is on
+    };
+
+    struct report {
+        double makespan = 0.0;        // largest virtual clock over all localities
+        std::int64_t messages = 0;
+        std::int64_t bytes = 0;
+        std::int64_t undelivered = 0; // messages whose target object was never created
+        std::int64_t shm_bytes = 0;   // part of bytes that went through shared memory rings
+    };
+
+private:
+
+    struct message {
+        std::int64_t target;
+        double arrival;
+        handler_priority priority;
+        std::function<bool(std::string &)> deliver;
+    };
+
+    // priority class first, high before normal, then delivery time
+    //
+    using queue_key = std::tuple<std::int32_t, std::chrono::steady_clock::time_point, std::int64_t>;
+
+    static std::int32_t priority_class(const handler_priority priority) {
+        return (priority == handler_priority::high) ? 0 : 1;
+    }
+
+    struct barrier_state {
+        std::int64_t count = 0;
+        std::int64_t generation = 0;
+        double clock = 0.0;
+        double release = 0.0;
+    };
+
+    struct simulation {
+        config cfg;
+        std::unique_ptr< std::atomic<double>[] > clocks;
+
+        std::mutex mtx;
+        std::condition_variable queue_cv, idle_cv, barrier_cv;
+        std::multimap< queue_key, message > queue;
+        std::map< std::pair<std::string, std::int64_t>, std::shared_ptr<void> > objects;
+        std::map< std::pair<std::string, std::int64_t>, std::vector<message> > parked;
+        std::map< std::string, barrier_state > barriers;
+        std::int64_t seq = 0, executing = 0;
+        bool stopping = false;
+
+        std::chrono::steady_clock::time_point deadline;
+        std::atomic<bool> aborted{false};
+        std::atomic<std::int64_t> messages{0}, bytes{0}, shm_bytes{0};
+
+        // real rings, named per run so concurrent or consecutive
+        // simulations never share a segment; each locality only touches
+        // its own slot of the node table
+        //
+        shm::domain shm_domain;
+        std::vector< std::shared_ptr< const std::vector<std::int64_t> > > shm_nodes;
+
+        explicit simulation(const config & cfg_) :
+            cfg(cfg_),
+            clocks(new std::atomic<double>[cfg_.localities]),
+            deadline(std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(cfg_.timeout))),
+            shm_domain(segment_prefix(), static_cast<std::uint64_t>(cfg_.shm_ring_size), static_cast<std::uint64_t>(cfg_.shm_threshold)),
+            shm_nodes(cfg_.localities) {
+            for(std::int64_t i = 0; i < cfg.localities; ++i) { clocks[i] = 0.0; }
+
+            if(cfg.shared_memory) {
+                const std::int64_t per_node = std::max<std::int64_t>(1, cfg.localities_per_node);
+                auto table = std::make_shared< std::vector<std::int64_t> >(cfg.localities);
+                for(std::int64_t i = 0; i < cfg.localities; ++i) { (*table)[i] = i / per_node; }
+                std::fill(shm_nodes.begin(), shm_nodes.end(), table);
+            }
+        }
+
+        static std::string segment_prefix() {
+            static std::atomic<std::int64_t> runs{0};
+            return "/hpx_collectives_sim_" + std::to_string(::getpid()) + "_" + std::to_string(runs++) + "_";
+        }
+
+        bool co_located(const std::int64_t source, const std::int64_t target) const {
+            const auto & table = shm_nodes[source];
+            return table && source != target && (*table)[source] == (*table)[target];
+        }
+    };
+
+    static simulation *& current() {
+        static simulation * sim = nullptr;
+        return sim;
+    }
+
+    static std::int64_t & current_rank() {
+        static thread_local std::int64_t rank = -1;
+        return rank;
+    }
+
+    static simulation & active() {
+        simulation * sim = current();
+        if(sim == nullptr) {
+            throw std::logic_error("hpx_collectives simulator: no simulation is running");
+        }
+        return *sim;
+    }
+
+    // once any locality has thrown, or the timeout has expired, every
+    // locality is unwound the next time it spins or waits so run() can
+    // report the error instead of deadlocking
+    //
+    static void check_aborted(simulation & sim) {
+        if(sim.cfg.timeout > 0.0 && std::chrono::steady_clock::now() > sim.deadline) {
+            sim.aborted = true;
+            throw std::runtime_error("hpx_collectives simulator: timed out, suspected deadlock");
+        }
+
+        if(sim.aborted.load()) {
+            throw std::runtime_error("hpx_collectives simulator: aborted, another locality failed");
+        }
+    }
+
+    static void advance_to(std::atomic<double> & clock, const double t) {
+        double now = clock.load();
+        while(now < t && !clock.compare_exchange_weak(now, t)) {}
+    }
+
+    static double advance_by(std::atomic<double> & clock, const double dt) {
+        double now = clock.load();
+        while(!clock.compare_exchange_weak(now, now + dt)) {}
+        return now;
+    }
+
+public:
+
+    template<typename T>
+    class distributed_object {
+
+        friend struct simulator;
+
+        std::string name_;
+        std::shared_ptr<T> value_;
+        bool owner_;
+
+        distributed_object(const std::string & name, std::shared_ptr<T> value) :
+            name_(name), value_(std::move(value)), owner_(false) {
+        }
+
+    public:
+        using value_type = T;
+
+        distributed_object(const std::string & name, T init) :
+            name_(name), value_(std::make_shared<T>(std::move(init))), owner_(true) {
+            simulator::register_object(name_, value_);
+        }
+
+        // every locality registers its own instance, so the members of
+        // a communicator need no special treatment here
+        //
+        distributed_object(const std::string & name, T init, const std::vector<std::int64_t> &) :
+            distributed_object(name, std::move(init)) {
+        }
+
+        distributed_object(const distributed_object & other) :
+            name_(other.name_), value_(other.value_), owner_(false) {
+        }
+
+        distributed_object & operator=(const distributed_object &) = delete;
+
+        ~distributed_object() {
+            if(owner_) { simulator::unregister_object(name_, value_); }
+        }
+
+        const std::string & name() const { return name_; }
+
+        T & operator*() { return *value_; }
+        const T & operator*() const { return *value_; }
+        T * operator->() { return value_.get(); }
+        const T * operator->() const { return value_.get(); }
+    };
+
+    class barrier {
+        std::string name;
+        std::int64_t size;
+
+    public:
+        barrier(const std::string & name_, const std::int64_t size_, const std::int64_t) :
+            name(name_), size(size_) {
+        }
+
+        void wait() {
+            simulation & sim = active();
+            const std::int64_t rank = rank_me();
+
+            std::unique_lock<std::mutex> lock(sim.mtx);
+            barrier_state & bs = sim.barriers[name];
+            const std::int64_t generation = bs.generation;
+            bs.clock = std::max(bs.clock, sim.clocks[rank].load());
+
+            if(++bs.count == size) {
+                // dissemination barrier, ceil(log2(p)) rounds of L + 2o
+                //
+                const double rounds = std::ceil(std::log2(static_cast<double>(std::max<std::int64_t>(size, 1))));
+                bs.release = bs.clock + rounds * (sim.cfg.latency + (2.0 * sim.cfg.overhead));
+                bs.clock = 0.0;
+                bs.count = 0;
+                ++bs.generation;
+                sim.barrier_cv.notify_all();
+            }
+            else {
+                const auto done = [&sim, &bs, generation]() { return bs.generation != generation || sim.aborted.load(); };
+                if(sim.cfg.timeout > 0.0) {
+                    sim.barrier_cv.wait_until(lock, sim.deadline, done);
+                }
+                else {
+                    sim.barrier_cv.wait(lock, done);
+                }
+
+                if(bs.generation == generation) {
+                    check_aborted(sim);
+                }
+            }
+
+            advance_to(sim.clocks[rank], bs.release);
+        }
+    };
+
+private:
+
+    template<typename T>
+    struct object_ref {
+        std::string name;
+    };
+
+    template<typename T>
+    struct is_object : public std::false_type {
+    };
+
+    template<typename T>
+    struct is_object< distributed_object<T> > : public std::true_type {
+    };
+
+    template<typename T>
+    struct is_object< std::reference_wrapper< distributed_object<T> > > : public std::true_type {
+    };
+
+    template<typename T>
+    struct is_object_ref : public std::false_type {
+    };
+
+    template<typename T>
+    struct is_object_ref< object_ref<T> > : public std::true_type {
+    };
+
+    template<typename T>
+    struct resolved {
+        using type = shm::unstaged_t<T>;
+    };
+
+    template<typename T>
+    struct resolved< object_ref<T> > {
+        using type = distributed_object<T>;
+    };
+
+    template<typename T>
+    static const distributed_object<T> & unwrap(const distributed_object<T> & obj) {
+        return obj;
+    }
+
+    template<typename T>
+    static const distributed_object<T> & unwrap(const std::reference_wrapper< distributed_object<T> > & obj) {
+        return obj.get();
+    }
+
+    // distributed_objects travel by name and are swapped for the target
+    // locality's instance on delivery; strings to a co-located locality
+    // are staged in its shm ring; everything else is copied, the same
+    // way it would be serialized into a parcel
+    //
+    template<typename A>
+    static auto marshal(simulation & sim, const std::int64_t source, const std::int64_t target, const bool staged, std::int64_t & shm_bytes, A && a) {
+        using arg_t = std::decay_t<A>;
+        if constexpr(is_object<arg_t>::value) {
+            const auto & obj = unwrap(a);
+            using obj_t = std::decay_t<decltype(obj)>;
+            return object_ref<typename obj_t::value_type>{obj.name()};
+        }
+        else if constexpr(std::is_same<shm::staged_t<arg_t>, arg_t>::value) {
+            return arg_t(std::forward<A>(a));
+        }
+        else if(staged) {
+            const std::int64_t nbytes = payload_size(a);
+            auto blocks = shm::stage(sim.shm_domain, source, target, std::forward<A>(a), []() { yield(); });
+            shm_bytes += nbytes - payload_size(blocks);
+            return blocks;
+        }
+        else {
+            return shm::carry(std::forward<A>(a));
+        }
+    }
+
+    template<typename A>
+    static std::int64_t payload_size(const A & a) {
+        if constexpr(is_object_ref<A>::value) {
+            return 0;
+        }
+        else if constexpr(std::is_same<A, std::string>::value) {
+            return static_cast<std::int64_t>(a.size());
+        }
+        else if constexpr(std::is_same<A, std::vector<std::string>>::value) {
+            std::int64_t total = 0;
+            for(const auto & s : a) { total += static_cast<std::int64_t>(s.size()); }
+            return total;
+        }
+        else if constexpr(std::is_same<A, shm::block>::value) {
+            return static_cast<std::int64_t>(a.inline_data.size());
+        }
+        else if constexpr(std::is_same<A, std::vector<shm::block>>::value) {
+            std::int64_t total = 0;
+            for(const auto & blk : a) { total += static_cast<std::int64_t>(blk.inline_data.size()); }
+            return total;
+        }
+        else {
+            return static_cast<std::int64_t>(sizeof(A));
+        }
+    }
+
+    template<typename A>
+    static bool lookup(simulation & sim, const std::int64_t target, const A & a, std::string & missing) {
+        if constexpr(is_object_ref<A>::value) {
+            std::lock_guard<std::mutex> lock(sim.mtx);
+            if(sim.objects.count({a.name, target}) < 1) {
+                missing = a.name;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename A>
+    static typename resolved<A>::type resolve(simulation & sim, const std::int64_t target, A && a) {
+        if constexpr(is_object_ref<A>::value) {
+            using T = typename resolved<A>::type::value_type;
+            std::lock_guard<std::mutex> lock(sim.mtx);
+            return distributed_object<T>{a.name, std::static_pointer_cast<T>(sim.objects.at({a.name, target}))};
+        }
+        else if constexpr(std::is_same<typename resolved<A>::type, A>::value) {
+            return std::move(a);
+        }
+        else {
+            return shm::unstage(sim.shm_domain, target, a);
+        }
+    }
+
+    template<typename T>
+    static void register_object(const std::string & name, const std::shared_ptr<T> & value) {
+        simulation & sim = active();
+        const std::pair<std::string, std::int64_t> key{name, rank_me()};
+
+        std::lock_guard<std::mutex> lock(sim.mtx);
+        sim.objects[key] = value;
+
+        auto parked_itr = sim.parked.find(key);
+        if(parked_itr != sim.parked.end()) {
+            for(auto & msg : parked_itr->second) {
+                sim.queue.emplace(queue_key{priority_class(msg.priority), std::chrono::steady_clock::now(), sim.seq++}, std::move(msg));
+            }
+            sim.parked.erase(parked_itr);
+            sim.queue_cv.notify_all();
+        }
+    }
+
+    template<typename T>
+    static void unregister_object(const std::string & name, const std::shared_ptr<T> & value) {
+        simulation * sim = current();
+        if(sim == nullptr) { return; }
+
+        std::lock_guard<std::mutex> lock(sim->mtx);
+        auto itr = sim->objects.find({name, rank_me()});
+        if(itr != sim->objects.end() && itr->second == value) {
+            sim->objects.erase(itr);
+        }
+    }
+
+    // the first message of the highest priority class that is due, or
+    // end() and the time the next one will be; only inject_delay holds
+    // messages back
+    //
+    static std::multimap< queue_key, message >::iterator next_message(simulation & sim, std::chrono::steady_clock::time_point & wake) {
+        const auto now = std::chrono::steady_clock::now();
+        wake = std::chrono::steady_clock::time_point::max();
+
+        for(auto itr = sim.queue.begin(); itr != sim.queue.end();
+            itr = sim.queue.lower_bound(queue_key{std::get<0>(itr->first) + 1, std::chrono::steady_clock::time_point::min(), 0})) {
+            if(!sim.cfg.inject_delay || std::get<1>(itr->first) <= now) { return itr; }
+            wake = std::min(wake, std::get<1>(itr->first));
+        }
+
+        return sim.queue.end();
+    }
+
+    static void deliver(simulation & sim) {
+        std::unique_lock<std::mutex> lock(sim.mtx);
+
+        while(true) {
+            sim.queue_cv.wait(lock, [&sim]() { return sim.stopping || !sim.queue.empty(); });
+            if(sim.queue.empty()) { return; }
+
+            std::chrono::steady_clock::time_point wake{};
+            auto itr = next_message(sim, wake);
+            if(itr == sim.queue.end()) {
+                sim.queue_cv.wait_until(lock, wake);
+                continue;
+            }
+
+            message msg = std::move(itr->second);
+            sim.queue.erase(itr);
+            ++sim.executing;
+            lock.unlock();
+
+            std::string missing{};
+            const std::int64_t prev_rank = current_rank();
+            current_rank() = msg.target;
+            advance_to(sim.clocks[msg.target], msg.arrival + sim.cfg.overhead);
+            const bool done = msg.deliver(missing);
+            current_rank() = prev_rank;
+
+            lock.lock();
+            --sim.executing;
+
+            if(!done) {
+                // target has not constructed the object yet; hold the
+                // message until register_object releases it
+                //
+                const std::pair<std::string, std::int64_t> key{missing, msg.target};
+                if(sim.objects.count(key) > 0) {
+                    sim.queue.emplace(queue_key{priority_class(msg.priority), std::chrono::steady_clock::now(), sim.seq++}, std::move(msg));
+                }
+                else {
+                    sim.parked[key].push_back(std::move(msg));
+                }
+            }
+
+            if(sim.queue.empty() && sim.executing == 0) {
+                sim.idle_cv.notify_all();
+            }
+        }
+    }
+
+public:
+
+    // spawns cfg.localities virtual localities, each running fn, and
+    // returns once every locality has finished and every message
+    // that can be delivered has been
+    //
+    static report run(const config & cfg, const std::function<void()> & fn) {
+        if(cfg.localities < 1) {
+            throw std::invalid_argument("hpx_collectives simulator: localities must be >= 1");
+        }
+
+        if(current() != nullptr) {
+            throw std::logic_error("hpx_collectives simulator: a simulation is already running");
+        }
+
+        simulation sim{cfg};
+        current() = &sim;
+
+        const std::int64_t delivery_n = (cfg.delivery_threads > 0) ? cfg.delivery_threads :
+            std::max<std::int64_t>(2, static_cast<std::int64_t>(std::thread::hardware_concurrency()));
+
+        std::vector<std::thread> delivery{};
+        delivery.reserve(delivery_n);
+        for(std::int64_t i = 0; i < delivery_n; ++i) {
+            delivery.emplace_back([&sim]() { deliver(sim); });
+        }
+
+        std::exception_ptr error{};
+        std::mutex error_mtx{};
+
+        std::vector<std::thread> localities{};
+        localities.reserve(cfg.localities);
+        for(std::int64_t rank = 0; rank < cfg.localities; ++rank) {
+            localities.emplace_back([&sim, &fn, &error, &error_mtx, rank]() {
+                current_rank() = rank;
+                try {
+                    fn();
+                }
+                catch(...) {
+                    {
+                        std::lock_guard<std::mutex> lock(error_mtx);
+                        if(!error) { error = std::current_exception(); }
+                    }
+
+                    std::lock_guard<std::mutex> lock(sim.mtx);
+                    sim.aborted = true;
+                    sim.barrier_cv.notify_all();
+                }
+                current_rank() = -1;
+            });
+        }
+
+        for(auto & locality : localities) { locality.join(); }
+
+        report rep{};
+        {
+            std::unique_lock<std::mutex> lock(sim.mtx);
+            sim.idle_cv.wait(lock, [&sim]() { return sim.queue.empty() && sim.executing == 0; });
+            sim.stopping = true;
+            sim.queue_cv.notify_all();
+
+            for(const auto & parked : sim.parked) {
+                rep.undelivered += static_cast<std::int64_t>(parked.second.size());
+            }
+        }
+
+        for(auto & thread : delivery) { thread.join(); }
+
+        for(std::int64_t i = 0; i < cfg.localities; ++i) {
+            rep.makespan = std::max(rep.makespan, sim.clocks[i].load());
+        }
+        rep.messages = sim.messages.load();
+        rep.bytes = sim.bytes.load();
+        rep.shm_bytes = sim.shm_bytes.load();
+
+        current() = nullptr;
+
+        if(error) { std::rethrow_exception(error); }
+
+        return rep;
+    }
+
+    template<typename F, typename... Args>
+    static void async(const handler_priority priority, const std::int64_t target, F && f, Args &&... args) {
+        simulation & sim = active();
+        const std::int64_t source = current_rank();
+
+        if(target < 0 || target >= sim.cfg.localities) {
+            throw std::out_of_range("hpx_collectives simulator: async target is not a locality");
+        }
+
+        // co-located pairs with shared memory enabled are charged the
+        // shm L and G for the whole message, inline part included
+        //
+        const bool staged = sim.co_located(source, target);
+        std::int64_t shm_bytes = 0;
+
+        auto payload = std::make_tuple(marshal(sim, source, target, staged, shm_bytes, std::forward<Args>(args))...);
+
+        const std::int64_t nbytes = shm_bytes + std::apply([](const auto &... a) {
+            return (std::int64_t{0} + ... + payload_size(a));
+        }, payload);
+
+        const double gap_per_byte = staged ? sim.cfg.shm_gap_per_byte : sim.cfg.gap_per_byte;
+        const double latency = staged ? sim.cfg.shm_latency : sim.cfg.latency;
+
+        const double transfer = (nbytes > 0) ? static_cast<double>(nbytes - 1) * gap_per_byte : 0.0;
+        const double start = advance_by(sim.clocks[source], std::max(sim.cfg.overhead + transfer, sim.cfg.gap));
+        const double arrival = start + sim.cfg.overhead + transfer + latency;
+
+        sim.messages += 1;
+        sim.bytes += nbytes;
+        sim.shm_bytes += shm_bytes;
+
+        message msg{target, arrival, priority,
+            [&sim, target, fn = std::decay_t<F>(std::forward<F>(f)), payload = std::move(payload)](std::string & missing) mutable {
+                const bool found = std::apply([&sim, target, &missing](const auto &... a) {
+                    return (true && ... && lookup(sim, target, a, missing));
+                }, payload);
+
+                if(!found) { return false; }
+
+                auto args_ = std::apply([&sim, target](auto &... a) {
+                    return std::tuple< typename resolved< std::decay_t<decltype(a)> >::type... >{
+                        resolve(sim, target, std::move(a))...
+                    };
+                }, payload);
+
+                std::apply(fn, args_);
+                return true;
+            }
+        };
+
+        const auto deliver_at = std::chrono::steady_clock::now() +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double, std::micro>(sim.cfg.inject_delay ? (arrival - start) : 0.0)
+            );
+
+        std::lock_guard<std::mutex> lock(sim.mtx);
+        sim.queue.emplace(queue_key{priority_class(priority), deliver_at, sim.seq++}, std::move(msg));
+        sim.queue_cv.notify_one();
+    }
+
+    static std::int64_t rank_me() {
+        const std::int64_t rank = current_rank();
+        return (rank < 0) ? 0 : rank;
+    }
+
+    static std::int64_t rank_n() {
+        simulation * sim = current();
+        return (sim == nullptr) ? 1 : sim->cfg.localities;
+    }
+
+    static void yield() {
+        simulation * sim = current();
+        if(sim != nullptr) { check_aborted(*sim); }
+        std::this_thread::yield();
+    }
+
+    // per locality, like one HPX process; cfg.shared_memory enables it
+    // for every locality from localities_per_node instead
+    //
+    static void enable_shared_memory(const std::vector<std::int64_t> & node_of_rank) {
+        active().shm_nodes[rank_me()] = std::make_shared< const std::vector<std::int64_t> >(node_of_rank);
+    }
+
+    static std::string hostname() {
+        const std::int64_t per_node = std::max<std::int64_t>(1, active().cfg.localities_per_node);
+        return "node" + std::to_string(rank_me() / per_node);
+    }
+
+    // virtual time of the calling locality, in microseconds
+    //
+    static double elapsed() {
+        return active().clocks[rank_me()].load();
+    }
+
+    // charge dt microseconds of modelled local computation to the
+    // calling locality
+    //
+    static void compute(const double dt) {
+        advance_by(active().clocks[rank_me()], dt);
+    }
+};
+
+#else
+
+struct simulator {};
+
+#endif
+
+template<typename Tag>
+struct is_simulator : public std::false_type {
+};
+
+template<>
+struct is_simulator<::hpx::utils::collectives::transport::simulator> : public std::true_type {
+};
+
+} } } } // end namespaces
+
+#endif
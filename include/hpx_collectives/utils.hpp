@@ -16,7 +16,10 @@ template<typename T>
 static inline bool atomic_cmp_ex(T * ptr, T expected, T desired) {
     T ex = expected;
     T de = desired;
-    return __atomic_compare_exchange(ptr, &expected, &desired, STRONG, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    // acquire/release so the mailbox payload written before a flag is
+    // flipped is visible to the locality that flips it back
+    //
+    return __atomic_compare_exchange(ptr, &expected, &desired, STRONG, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
 }
 
 static inline bool compare_and_swap(volatile int * cond, int old_, int new_) {